@@ -30,8 +30,39 @@ extern "C" {
 
 /******************************************************************************/
 
+/** Amount of cells in each dimension of the point location hints grid.
+ */
+#define TRIANGLE_HINT_GRID_DIM 64
+
+/** Shift converting triangulation coordinate to hints grid cell.
+ */
+#define TRIANGLE_HINT_CELL_SHIFT 10
+
 int triangle_find8(TrFineCoord pt_x, TrFineCoord pt_y);
 
+/** Returns triangle suggested as start of a walk searching for given point.
+ *
+ * The hints grid remembers, for each area of the map, a triangle which was
+ * recently found there. The hint is only a starting point - triangles are
+ * modified in place when the triangulation changes, so the returned one
+ * might no longer contain the point, but is usually close to it.
+ *
+ * @return Allocated triangle index, or -1 if no hint is available.
+ */
+TrTriangId triangle_find_hint(TrFineCoord pt_x, TrFineCoord pt_y);
+
+/** Stores triangle found at given point as hint for further searches.
+ */
+void triangle_find_hint_set(TrFineCoord pt_x, TrFineCoord pt_y, TrTriangId tri);
+
+/** Clears point location hints of the currently selected triangulation.
+ */
+void triangle_find_hints_clear(void);
+
+/** Clears point location hints of all triangulations.
+ */
+void triangle_find_hints_clear_all(void);
+
 /******************************************************************************/
 #ifdef __cplusplus
 }
@@ -0,0 +1,87 @@
+/******************************************************************************/
+// Bullfrog Ariadne Pathfinding Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file trroute.h
+ *     Header file for trroute.c.
+ * @par Purpose:
+ *     Cache of routes found between triangles.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef ARIADNE_TRROUTE_H
+#define ARIADNE_TRROUTE_H
+
+#include "bftypes.h"
+#include "triangls.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+
+enum TrRouteSearchKind {
+    /** Search which starts at the triangle where the route begins. */
+    TrRSrch_Forward = 0,
+    /** Search which starts at the triangle where the route ends. */
+    TrRSrch_Backward,
+};
+
+/** Amount of corridor searches remembered by the cache.
+ */
+#define TRIANGLE_ROUTE_CACHE_COUNT 128
+
+/** Max amount of triangles in a route which can be cached.
+ */
+#define TRIANGLE_ROUTE_CACHE_MAX_LEN 256
+
+/** Value returned by triangle_route_cache_get() if the route is not cached.
+ */
+#define TRIANGLE_ROUTE_NOT_CACHED -2
+
+/** Gets result of a corridor search between given triangles from the cache.
+ *
+ * Only the list of triangles is cached; converting it to a path, and computing
+ * the path cost, depends on the exact points and has to be done by the caller.
+ *
+ * @param kind Search kind, from TrRouteSearchKind enumeration.
+ * @param tri_from Triangle where the search starts.
+ * @param tri_to Triangle where the search ends.
+ * @param heur_x Tile X coordinate used by the search heuristic.
+ * @param heur_y Tile Y coordinate used by the search heuristic.
+ * @param route Output array for triangles along the route.
+ * @return Index of last triangle in route, -1 if it was found that there is
+ *  no route, or TRIANGLE_ROUTE_NOT_CACHED.
+ */
+int triangle_route_cache_get(ubyte kind, TrTriangId tri_from, TrTriangId tri_to,
+  s32 heur_x, s32 heur_y, int *route);
+
+/** Stores result of a corridor search between given triangles in the cache.
+ *
+ * @param route_len Index of last triangle in route, or -1 if no route exists.
+ */
+void triangle_route_cache_put(ubyte kind, TrTriangId tri_from, TrTriangId tri_to,
+  s32 heur_x, s32 heur_y, const int *route, int route_len);
+
+/** Drops all cached routes.
+ *
+ * To be called whenever the triangulation changes, and at start of each
+ * game turn - the cache is not stored in saved games, so it cannot live
+ * longer than a turn without affecting the simulation.
+ */
+void triangle_route_cache_clear(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -17,13 +17,74 @@
  *     (at your option) any later version.
  */
 /******************************************************************************/
-#include "triangls.h"
+#include "trfind8.h"
 
 #include <limits.h>
 #include <stdlib.h>
+#include "bfmemut.h"
+#include "triangls.h"
 #include "trstate.h"
 #include "trlog.h"
 /******************************************************************************/
 
+/** Lowest coordinate used by triangulations; matches bounds in triangulation_init().
+ */
+#define TRIANGLE_HINT_COORD_MIN (-4096)
+
+/** Point location hints for each triangulation state.
+ *
+ * Indexed by selected_triangulation_no, as triangulation_select() swaps
+ * the state in and out of triangulation[0].
+ */
+static TrTriangId triangle_hints[TRIANGULATIONS_COUNT][TRIANGLE_HINT_GRID_DIM][TRIANGLE_HINT_GRID_DIM];
+
+static int triangle_hint_cell(TrFineCoord pt)
+{
+    int cell;
+
+    cell = ((pt >> 8) - TRIANGLE_HINT_COORD_MIN) >> TRIANGLE_HINT_CELL_SHIFT;
+    if (cell < 0)
+        cell = 0;
+    if (cell > TRIANGLE_HINT_GRID_DIM - 1)
+        cell = TRIANGLE_HINT_GRID_DIM - 1;
+    return cell;
+}
+
+TrTriangId triangle_find_hint(TrFineCoord pt_x, TrFineCoord pt_y)
+{
+    TrTriangId tri;
+
+    if ((selected_triangulation_no < 0) || (selected_triangulation_no >= TRIANGULATIONS_COUNT))
+        return -1;
+    tri = triangle_hints[selected_triangulation_no]
+      [triangle_hint_cell(pt_y)][triangle_hint_cell(pt_x)];
+    // Hint may be outdated if the triangle was freed after it was stored
+    if ((tri < 0) || (tri >= triangulation[0].ix_Triangles) || !tri_is_allocated(tri))
+        return -1;
+    return tri;
+}
+
+void triangle_find_hint_set(TrFineCoord pt_x, TrFineCoord pt_y, TrTriangId tri)
+{
+    if ((selected_triangulation_no < 0) || (selected_triangulation_no >= TRIANGULATIONS_COUNT))
+        return;
+    triangle_hints[selected_triangulation_no]
+      [triangle_hint_cell(pt_y)][triangle_hint_cell(pt_x)] = tri;
+}
+
+void triangle_find_hints_clear(void)
+{
+    if ((selected_triangulation_no < 0) || (selected_triangulation_no >= TRIANGULATIONS_COUNT))
+        return;
+    // Setting all bytes to 0xFF fills the grid with -1
+    LbMemorySet(triangle_hints[selected_triangulation_no], 0xFF,
+      sizeof(triangle_hints[0]));
+}
+
+void triangle_find_hints_clear_all(void)
+{
+    LbMemorySet(triangle_hints, 0xFF, sizeof(triangle_hints));
+}
+
 
 /******************************************************************************/
@@ -22,6 +22,7 @@
 #include <limits.h>
 #include <stdlib.h>
 #include "trstate.h"
+#include "trroute.h"
 #include "trlog.h"
 /******************************************************************************/
 
@@ -400,6 +401,7 @@ void triangulation_clear_enter_into_solid_gnd(void)
         return;
     }
 
+    triangle_route_cache_clear();
     for (tri = 0; tri < triangulation[0].ix_Triangles; tri++)
     {
         triangle_clear_enter_into_solid_gnd(tri);
@@ -416,6 +418,7 @@ void triangulation_clear_enter_into_solid_air(void)
         return;
     }
 
+    triangle_route_cache_clear();
     for (tri = 0; tri < triangulation[0].ix_Triangles; tri++)
     {
         triangle_clear_enter_into_solid_air(tri);
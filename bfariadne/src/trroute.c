@@ -0,0 +1,116 @@
+/******************************************************************************/
+// Bullfrog Ariadne Pathfinding Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file trroute.c
+ *     Cache of routes found between triangles.
+ * @par Purpose:
+ *     Allows crowds moving to the same place to reuse corridor searches.
+ * @par Comment:
+ *     Only the point-independent part is cached - the list of triangles.
+ *     The search heuristic uses tile coordinates of one of the points,
+ *     so these are a part of the key. Entries stay valid until
+ *     the triangulation is modified, or the game turn ends.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "trroute.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include "trstate.h"
+#include "trlog.h"
+/******************************************************************************/
+
+struct TrRouteCacheEntry {
+    /** Generation of the cache in which the entry was stored; entry is valid only if it matches. */
+    ulong gen;
+    int trgl_no;
+    ubyte kind;
+    TrTriangId tri_from;
+    TrTriangId tri_to;
+    s32 heur_x;
+    s32 heur_y;
+    /** Index of last triangle in route, or -1 if there is no route. */
+    short route_len;
+    TrTriangId route[TRIANGLE_ROUTE_CACHE_MAX_LEN];
+};
+
+static struct TrRouteCacheEntry route_cache[TRIANGLE_ROUTE_CACHE_COUNT];
+
+/** Current cache generation; increasing it drops all entries at once.
+ * Starts at 1, as zeroed entries have generation 0.
+ */
+static ulong route_cache_gen = 1;
+
+static struct TrRouteCacheEntry *triangle_route_cache_entry(ubyte kind,
+  TrTriangId tri_from, TrTriangId tri_to, s32 heur_x, s32 heur_y)
+{
+    ulong hash;
+
+    hash = (ushort)tri_from * 31 + (ushort)tri_to * 7 + (ulong)selected_triangulation_no;
+    hash = hash * 17 + (ulong)(heur_x * 5 + heur_y) + kind;
+    return &route_cache[hash % TRIANGLE_ROUTE_CACHE_COUNT];
+}
+
+int triangle_route_cache_get(ubyte kind, TrTriangId tri_from, TrTriangId tri_to,
+  s32 heur_x, s32 heur_y, int *route)
+{
+    struct TrRouteCacheEntry *p_entry;
+    int i;
+
+    p_entry = triangle_route_cache_entry(kind, tri_from, tri_to, heur_x, heur_y);
+    if ((p_entry->gen != route_cache_gen) || (p_entry->trgl_no != selected_triangulation_no) ||
+      (p_entry->kind != kind) || (p_entry->tri_from != tri_from) || (p_entry->tri_to != tri_to) ||
+      (p_entry->heur_x != heur_x) || (p_entry->heur_y != heur_y))
+        return TRIANGLE_ROUTE_NOT_CACHED;
+
+    for (i = 0; i <= p_entry->route_len; i++)
+        route[i] = p_entry->route[i];
+    return p_entry->route_len;
+}
+
+void triangle_route_cache_put(ubyte kind, TrTriangId tri_from, TrTriangId tri_to,
+  s32 heur_x, s32 heur_y, const int *route, int route_len)
+{
+    struct TrRouteCacheEntry *p_entry;
+    int i;
+
+    if (route_len >= TRIANGLE_ROUTE_CACHE_MAX_LEN)
+        return;
+    if (route_len < 0)
+        route_len = -1;
+
+    p_entry = triangle_route_cache_entry(kind, tri_from, tri_to, heur_x, heur_y);
+    p_entry->gen = route_cache_gen;
+    p_entry->trgl_no = selected_triangulation_no;
+    p_entry->kind = kind;
+    p_entry->tri_from = tri_from;
+    p_entry->tri_to = tri_to;
+    p_entry->heur_x = heur_x;
+    p_entry->heur_y = heur_y;
+    p_entry->route_len = route_len;
+    for (i = 0; i <= route_len; i++)
+        p_entry->route[i] = route[i];
+}
+
+void triangle_route_cache_clear(void)
+{
+    int i;
+
+    route_cache_gen++;
+    if (route_cache_gen != 0)
+        return;
+    // On wrap-around, old entries could become valid again
+    for (i = 0; i < TRIANGLE_ROUTE_CACHE_COUNT; i++)
+        route_cache[i].gen = 0;
+    route_cache_gen = 1;
+}
+
+/******************************************************************************/
@@ -22,6 +22,8 @@
 #include <limits.h>
 #include <stdlib.h>
 #include "trstate.h"
+#include "trfind8.h"
+#include "trroute.h"
 #include "trlog.h"
 /******************************************************************************/
 
@@ -47,6 +49,8 @@ void triangulation_initialize(void)
         triangulation[n].max_Points = 0;
         triangulation[n].Points = 0;
     }
+    triangle_find_hints_clear_all();
+    triangle_route_cache_clear();
 
     triangulation_initied = 1;
 }
@@ -0,0 +1,78 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file bfasync.h
+ *     Header file for sasync.c.
+ * @par Purpose:
+ *     Loading files on a background thread.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef BFLIBRARY_BFASYNC_H_
+#define BFLIBRARY_BFASYNC_H_
+
+#include "bftypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max amount of file loads which can be queued at the same time.
+ */
+#define ASYNC_FILE_JOBS_LIMIT 16
+
+/** Callback executed by the main thread while it waits for a background load.
+ */
+typedef void (*TbAsyncFileIdleCallback)(void);
+
+/** Queues loading of a file on the background thread.
+ *
+ * The file is read and, if it is RNC compressed, unpacked into a buffer owned
+ * by the queue, until LbAsyncFileLoadAt() collects it. Requesting a file which
+ * is already queued does nothing.
+ *
+ * @param fname Name of the file to load.
+ * @return Lb_SUCCESS if the load was queued, Lb_FAIL if it will have to be done
+ *   without the background thread.
+ */
+TbResult LbAsyncFileRequest(const char *fname);
+
+/** Loads a file into given buffer, using the background load if it was requested.
+ *
+ * If the file was queued by LbAsyncFileRequest(), waits for the load to
+ * finish, and copies the data. While waiting, the idle callback is executed
+ * repeatedly. If the file was not queued, it is loaded with LbFileLoadAt().
+ *
+ * @param fname Name of the file to load.
+ * @param buffer Destination buffer; needs to be large enough for the unpacked file.
+ * @param idle_cb Callback to execute while waiting, or NULL.
+ * @return Size of the loaded data, or -1 on failure.
+ */
+long LbAsyncFileLoadAt(const char *fname, void *buffer, TbAsyncFileIdleCallback idle_cb);
+
+/** Drops all queued and finished loads which were not collected.
+ * A load in progress is finished by the background thread, and then dropped.
+ */
+void LbAsyncFileCancelAll(void);
+
+/** Drops all loads and stops the background thread.
+ * Waits for a load in progress to finish. The thread is started again
+ * by the next LbAsyncFileRequest().
+ */
+void LbAsyncFileShutdown(void);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // BFLIBRARY_BFASYNC_H_
+/******************************************************************************/
@@ -83,6 +83,26 @@ void LbScreenCopyRemap(TbPixel *sourceBuf, TbPixel *destBuf, ushort height,
  */
 void LbScreenSave(TbPixel *sourceBuf, TbPixel *destBuf, ushort height);
 
+/** Copies a buffer into another one of larger or equal size, scaling it.
+ *
+ * Uses nearest neighbour filtering; colour mixing would require palette
+ * lookups, and 8-bit pixels of one buffer would not look better when mixed.
+ * Destination lines mapped to the same source line are copied from the line
+ * above, and exact 2x horizontal scaling doubles pixels without the lookup.
+ *
+ * @param sourceBuf The buffer to copy from
+ * @param sourceWidth Width of the source image
+ * @param sourceHeight Height of the source image
+ * @param sourceScanln Length of the source buffer line
+ * @param destBuf The buffer to copy into
+ * @param destWidth Width of the destination image
+ * @param destHeight Height of the destination image
+ * @param destScanln Length of the destination buffer line
+ */
+void LbScreenCopyScaled(const TbPixel *sourceBuf, ulong sourceWidth,
+  ulong sourceHeight, ulong sourceScanln, TbPixel *destBuf,
+  ulong destWidth, ulong destHeight, ulong destScanln);
+
 #ifdef __cplusplus
 };
 #endif
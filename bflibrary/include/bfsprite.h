@@ -98,6 +98,15 @@ TbResult LbSpriteReset(TbSprite *start, const TbSprite *end, const unsigned char
 
 TbResult LbSpriteResetAll();
 
+/** Forget all sprites decoded for scaled drawing, and free memory used by them.
+ *
+ * Sprites are decoded from RLE data on first scaled draw, and the decoded form
+ * is reused while sprite data pointer and size stay the same. Setup and reset
+ * of sprite arrays call this automatically; it only needs to be called directly
+ * if sprite data is modified in place.
+ */
+void LbSpriteCacheReset(void);
+
 extern ubyte * lbSpriteReMapPtr;
 
 TbResult LbSpriteDrawOneColour(long x, long y, const TbSprite *spr, const TbPixel colour);
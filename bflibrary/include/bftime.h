@@ -80,6 +80,13 @@ TbResult LbDateTime(struct TbDate *curr_date, struct TbTime *curr_time);
  */
 TbClockMSec LbTimerClock(void);
 
+/** Returns the number of microseconds elapsed since the program was launched.
+ *
+ * Meant for measuring short intervals; the starting point is arbitrary,
+ * only differences between two values are meaningful.
+ */
+TbClockUSec LbTimerClockMicro(void);
+
 /** Sleep until LbTimerClock() returns given value.
  */
 TbBool LbSleepUntil(TbClockMSec endtime);
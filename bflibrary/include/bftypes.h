@@ -164,6 +164,7 @@ typedef short TbScreenCoord;
 typedef unsigned char TbPixel;
 
 typedef long long TbClockMSec;
+typedef long long TbClockUSec;
 typedef time_t TbTimeSec;
 
 #ifdef __cplusplus
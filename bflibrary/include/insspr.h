@@ -75,6 +75,36 @@ void LbSpriteClearScalingHeightArray(long * ysteps_arr, long sheight);
 
 void LbPixelBlockCopyForward(TbPixel * dst, const TbPixel * src, long len);
 
+/** Pixel operations for drawing decoded sprites.
+ */
+enum TbSpriteBlend {
+    SprBl_Solid = 0,    /**< Copy sprite pixels. */
+    SprBl_Remap,        /**< Copy sprite pixels through colour map. */
+    SprBl_TransSrcDst,  /**< Mix using table with sprite pixel as high byte of the index. */
+    SprBl_TransDstSrc,  /**< Mix using table with screen pixel as high byte of the index. */
+};
+
+/**
+ * Draws a scaled sprite on given buffer, using its decoded form from sprites cache.
+ * Requires step arrays for scaling. Replaces drawing variants for each direction
+ * and blending, which decoded the sprite RLE data on each call.
+ *
+ * @param outbuf The output buffer, at first drawn pixel.
+ * @param scanline Length of the output buffer scanline; negative for vertical flip.
+ * @param outheight Amount of lines in the output buffer.
+ * @param xstep Scaling steps array, x dimension, at first drawn column.
+ * @param ystep Scaling steps array, y dimension, at first drawn line.
+ * @param flip_horiz Whether the sprite is to be drawn from right to left.
+ * @param scale_up Whether the step arrays were prepared for enlarging the sprite.
+ * @param sprite The source sprite.
+ * @param blend Pixel operation, from TbSpriteBlend enumeration.
+ * @param table Colour map or transparency table used by the blending, if any.
+ * @return Gives 0 on success.
+ */
+TbResult LbSpriteDrawDecodedUsingScaling(ubyte *outbuf, int scanline, int outheight,
+  long *xstep, long *ystep, TbBool flip_horiz, TbBool scale_up,
+  const TbSprite *sprite, ubyte blend, const TbPixel *table);
+
 #ifdef __cplusplus
 };
 #endif
@@ -41,6 +41,7 @@ TbResult LbSpriteSetup(TbSprite *start, const TbSprite *end, const unsigned char
       sprt++;
     }
     LOGDBG("initiated %d of %d sprites", n, (sprt-start));
+    LbSpriteCacheReset();
     return Lb_SUCCESS;
 }
 
@@ -78,6 +79,7 @@ TbResult LbSpriteReset(TbSprite *start, const TbSprite *end, const unsigned char
       sprt++;
     }
     LOGDBG("reset %d of %d sprites", n, (sprt-start));
+    LbSpriteCacheReset();
     return Lb_SUCCESS;
 }
 
@@ -99,6 +101,7 @@ TbResult LbSpriteClearAll(TbSetupSprite t_setup[])
         stp_sprite=&t_setup[idx];
     }
     LOGSYNC("cleaned %d SetupSprite lists", idx);
+    LbSpriteCacheReset();
     return Lb_SUCCESS;
 }
 /******************************************************************************/
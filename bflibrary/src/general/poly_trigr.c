@@ -69,6 +69,461 @@ static inline ulong __ROL4__(ulong value, int count)
     return value;
 }
 
+/** Span of one triangle scanline, with texture and shade coordinates
+ * at its first pixel.
+ *
+ * The coordinates are 16.16 fixed point; only lowest 8 bits of the integer
+ * part are used. Adding whole 32-bit values gives exactly the same integer
+ * parts as the byte-split additions with carry which the rendering loops
+ * transliterated from assembly do.
+ */
+struct TrigSpan {
+    ubyte *o;
+    ushort len;
+    u32 U;
+    u32 V;
+    u32 S;
+};
+
+/** Modes of drawing a span, for rendering modes which share span kernels.
+ */
+enum TrigSpanMode {
+    TrSM_Tex = 0,         /**< texture; mode 2 */
+    TrSM_TexKey,          /**< texture with colour 0 transparent; mode 3 */
+    TrSM_TexFadeKey,      /**< shaded texture with colour 0 transparent; mode 6 */
+    TrSM_TexGhostCol,     /**< texture translucent over vec_colour; mode 12 */
+    TrSM_ColGhostTex,     /**< vec_colour translucent over texture; mode 13 */
+    TrSM_TexFadeGhostDst, /**< shaded texture translucent over screen; mode 20 */
+    TrSM_DstGhostTexFade, /**< screen translucent over shaded texture; mode 21 */
+};
+
+enum TrigSpanKernel {
+    TrSK_Unknown = 0,
+    TrSK_Scalar,
+    TrSK_AVX2,
+};
+
+static ubyte trig_span_kernel = TrSK_Unknown;
+
+/** Clips next scanline to the window and computes coordinates at its start.
+ * Returns false if there is nothing to draw in the line.
+ */
+static inline TbBool trig_span_prepare(struct TrigLocalRend *tlr,
+  const struct PolyPoint *pp, struct TrigSpan *p_spn)
+{
+    short pX, pY;
+    u32 skip;
+
+    pX = pp->X >> 16;
+    pY = pp->Y >> 16;
+    p_spn->o = &tlr->var_24[vec_screen_width];
+    tlr->var_24 += vec_screen_width;
+
+    if (pX < 0)
+    {
+        if (pY <= 0)
+            return false;
+        if (pY > vec_window_width)
+            pY = vec_window_width;
+        skip = (ushort)-pX;
+    }
+    else
+    {
+        if (pY > vec_window_width)
+            pY = vec_window_width;
+        if (pY <= pX)
+            return false;
+        pY -= pX;
+        p_spn->o += pX;
+        skip = 0;
+    }
+    p_spn->len = pY;
+    p_spn->U = pp->U + tlr->var_48 * skip;
+    p_spn->V = pp->V + tlr->var_54 * skip;
+    p_spn->S = pp->S + tlr->var_60 * skip;
+    return true;
+}
+
+static inline u32 trig_span_texel(u32 u, u32 v)
+{
+    return ((v >> 8) & 0xFF00) | ((u >> 16) & 0xFF);
+}
+
+static inline ubyte trig_span_pixel(ubyte mode, ubyte dst, ubyte tex, ubyte shd)
+{
+    switch (mode)
+    {
+    case TrSM_Tex:
+    default:
+        return tex;
+    case TrSM_TexKey:
+        return (tex != 0) ? tex : dst;
+    case TrSM_TexFadeKey:
+        return (tex != 0) ? pixmap.fade_table[(shd << 8) | tex] : dst;
+    case TrSM_TexGhostCol:
+        return pixmap.ghost_table[(tex << 8) | vec_colour];
+    case TrSM_ColGhostTex:
+        return pixmap.ghost_table[(vec_colour << 8) | tex];
+    case TrSM_TexFadeGhostDst:
+        return pixmap.ghost_table[(pixmap.fade_table[(shd << 8) | tex] << 8) | dst];
+    case TrSM_DstGhostTexFade:
+        return pixmap.ghost_table[(dst << 8) | pixmap.fade_table[(shd << 8) | tex]];
+    }
+}
+
+static inline void trig_span_loop_scalar(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, const ubyte *m, ubyte mode)
+{
+    ubyte *o;
+    u32 u, v, s;
+    long n;
+
+    o = p_spn->o;
+    u = p_spn->U;
+    v = p_spn->V;
+    s = p_spn->S;
+    for (n = p_spn->len; n > 0; n--, o++)
+    {
+        *o = trig_span_pixel(mode, *o, m[trig_span_texel(u, v)], s >> 16);
+        u += tlr->var_48;
+        v += tlr->var_54;
+        s += tlr->var_60;
+    }
+}
+
+static void trig_span_draw_scalar(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, const ubyte *m, ubyte mode)
+{
+    // Separate loop for each mode, so that the mode is not checked per pixel
+    switch (mode)
+    {
+    case TrSM_Tex:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_Tex);
+        break;
+    case TrSM_TexKey:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_TexKey);
+        break;
+    case TrSM_TexFadeKey:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_TexFadeKey);
+        break;
+    case TrSM_TexGhostCol:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_TexGhostCol);
+        break;
+    case TrSM_ColGhostTex:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_ColGhostTex);
+        break;
+    case TrSM_TexFadeGhostDst:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_TexFadeGhostDst);
+        break;
+    case TrSM_DstGhostTexFade:
+        trig_span_loop_scalar(p_spn, tlr, m, TrSM_DstGhostTexFade);
+        break;
+    }
+}
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define LB_TRIG_HAVE_X86_SIMD 1
+#include <immintrin.h>
+
+/** Gathers 8 bytes from given table, for lanes enabled in the mask.
+ *
+ * Each lane reads a dword ending at the indexed byte, so nothing beyond
+ * the indexed bytes is accessed. Lanes with index below 3 are read
+ * separately, to avoid reading before the table.
+ */
+__attribute__((target("avx2")))
+static inline __m256i trig_gather8_avx2(const ubyte *tbl, __m256i idx, __m256i mask)
+{
+    __m256i low_idx, val;
+
+    low_idx = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), idx);
+    val = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)tbl,
+      _mm256_sub_epi32(idx, _mm256_set1_epi32(3)), _mm256_andnot_si256(low_idx, mask), 1);
+    val = _mm256_srli_epi32(val, 24);
+    if (!_mm256_testz_si256(low_idx, mask))
+    {
+        u32 idx_arr[8], val_arr[8], mask_arr[8];
+        int k;
+
+        _mm256_storeu_si256((__m256i *)idx_arr, idx);
+        _mm256_storeu_si256((__m256i *)val_arr, val);
+        _mm256_storeu_si256((__m256i *)mask_arr, mask);
+        for (k = 0; k < 8; k++) {
+            if ((idx_arr[k] < 3) && (mask_arr[k] != 0))
+                val_arr[k] = tbl[idx_arr[k]];
+        }
+        val = _mm256_loadu_si256((const __m256i *)val_arr);
+    }
+    return val;
+}
+
+/** Packs 8 dwords of values 0..255 into 8 bytes.
+ */
+__attribute__((target("avx2")))
+static inline __m128i trig_pack8_avx2(__m256i val)
+{
+    val = _mm256_packus_epi32(val, val);
+    val = _mm256_packus_epi16(val, val);
+    return _mm_unpacklo_epi32(_mm256_castsi256_si128(val),
+      _mm256_extracti128_si256(val, 1));
+}
+
+__attribute__((target("avx2")))
+static inline void trig_span_draw_avx2(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, const ubyte *m, ubyte mode)
+{
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i all = _mm256_set1_epi32(-1);
+    __m256i u8, v8, s8, du8, dv8, ds8;
+    struct TrigSpan spn;
+    long n;
+
+    spn = *p_spn;
+    u8 = _mm256_add_epi32(_mm256_set1_epi32(spn.U), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(tlr->var_48)));
+    v8 = _mm256_add_epi32(_mm256_set1_epi32(spn.V), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(tlr->var_54)));
+    s8 = _mm256_add_epi32(_mm256_set1_epi32(spn.S), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(tlr->var_60)));
+    du8 = _mm256_set1_epi32(tlr->var_48 * 8);
+    dv8 = _mm256_set1_epi32(tlr->var_54 * 8);
+    ds8 = _mm256_set1_epi32(tlr->var_60 * 8);
+
+    for (n = spn.len; n >= 8; n -= 8)
+    {
+        __m256i idx, tex, shd, px;
+        __m128i px_b, dst_b;
+
+        idx = _mm256_or_si256(
+          _mm256_and_si256(_mm256_srli_epi32(v8, 8), _mm256_set1_epi32(0xFF00)),
+          _mm256_and_si256(_mm256_srli_epi32(u8, 16), _mm256_set1_epi32(0xFF)));
+        tex = trig_gather8_avx2(m, idx, all);
+        shd = _mm256_and_si256(_mm256_srli_epi32(s8, 8), _mm256_set1_epi32(0xFF00));
+        dst_b = _mm_loadl_epi64((const __m128i *)spn.o);
+        switch (mode)
+        {
+        case TrSM_Tex:
+        default:
+            px = tex;
+            break;
+        case TrSM_TexKey:
+            px = tex;
+            break;
+        case TrSM_TexFadeKey:
+            px = trig_gather8_avx2(pixmap.fade_table, _mm256_or_si256(shd, tex),
+              _mm256_xor_si256(_mm256_cmpeq_epi32(tex, _mm256_setzero_si256()), all));
+            break;
+        }
+        px_b = trig_pack8_avx2(px);
+        if ((mode == TrSM_TexKey) || (mode == TrSM_TexFadeKey)) {
+            __m128i key;
+            key = _mm_cmpeq_epi8(trig_pack8_avx2(tex), _mm_setzero_si128());
+            px_b = _mm_blendv_epi8(px_b, dst_b, key);
+        }
+        _mm_storel_epi64((__m128i *)spn.o, px_b);
+
+        spn.o += 8;
+        u8 = _mm256_add_epi32(u8, du8);
+        v8 = _mm256_add_epi32(v8, dv8);
+        s8 = _mm256_add_epi32(s8, ds8);
+    }
+    if (n > 0)
+    {
+        spn.len = n;
+        spn.U = _mm256_cvtsi256_si32(u8);
+        spn.V = _mm256_cvtsi256_si32(v8);
+        spn.S = _mm256_cvtsi256_si32(s8);
+        trig_span_draw_scalar(&spn, tlr, m, mode);
+    }
+}
+#endif
+
+static void trig_span_kernel_select(void)
+{
+    trig_span_kernel = TrSK_Scalar;
+#if defined(LB_TRIG_HAVE_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        trig_span_kernel = TrSK_AVX2;
+#endif
+    LOGDBG("selected triangle span kernel %d", (int)trig_span_kernel);
+}
+
+/** Gives span kernel to be used for given span mode.
+ *
+ * Modes which look up the ghost table are slower with AVX2 gathers than
+ * with scalar reads, as the lanes hit random places within the 64k table;
+ * these always use the scalar kernel.
+ */
+static inline ubyte trig_span_kernel_for_mode(ubyte mode)
+{
+    switch (mode)
+    {
+    case TrSM_Tex:
+    case TrSM_TexKey:
+    case TrSM_TexFadeKey:
+        return trig_span_kernel;
+    default:
+        return TrSK_Scalar;
+    }
+}
+
+/** Draws all scanlines prepared for the triangle, in given span mode.
+ */
+static void trig_render_spans(struct TrigLocalRend *tlr,
+  const struct PolyPoint *pp, const ubyte *m, ubyte mode)
+{
+    ubyte kernel;
+
+    if (trig_span_kernel == TrSK_Unknown)
+        trig_span_kernel_select();
+    kernel = trig_span_kernel_for_mode(mode);
+
+    for (; tlr->var_44; tlr->var_44--, pp++)
+    {
+        struct TrigSpan spn;
+
+        if (!trig_span_prepare(tlr, pp, &spn))
+            continue;
+#if defined(LB_TRIG_HAVE_X86_SIMD)
+        if (kernel == TrSK_AVX2) {
+            trig_span_draw_avx2(&spn, tlr, m, mode);
+            continue;
+        }
+#endif
+        trig_span_draw_scalar(&spn, tlr, m, mode);
+    }
+}
+
+/** Gives the mode 5 span state as one wide accumulator.
+ *
+ * The loop of mode 5 keeps coordinates packed in two dwords, added with
+ * carry chained from one into the other, and then into V coordinate byte.
+ * The packed fields overflow into each other, so they are kept as one 72-bit
+ * value; lowest 64 bits in *p_x, and the top 8 bits in *p_h.
+ */
+static inline void trig_span_md05_coords(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, u64 *p_x, ubyte *p_h, u64 *p_dx, ubyte *p_dh)
+{
+    u32 lo, hi;
+
+    lo = ((p_spn->U & 0xFFFF) << 16) | ((p_spn->S >> 8) & 0xFFFF);
+    hi = ((p_spn->V & 0xFFFF) << 16) | ((p_spn->U >> 16) & 0xFF);
+    *p_x = ((u64)hi << 32) | lo;
+    *p_h = (p_spn->V >> 16) & 0xFF;
+
+    lo = ((tlr->var_48 & 0xFFFF) << 16) | (((u32)tlr->var_60 >> 8) & 0xFFFF);
+    hi = ((tlr->var_54 & 0xFFFF) << 16) | (((u32)tlr->var_54 >> 24) << 8) |
+      ((tlr->var_48 >> 16) & 0xFF);
+    *p_dx = ((u64)hi << 32) | lo;
+    *p_dh = (tlr->var_54 >> 16) & 0xFF;
+}
+
+static void trig_span_md05_scalar(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, const ubyte *m, const ubyte *f)
+{
+    ubyte *o;
+    u64 x, dx;
+    ubyte h, dh;
+    long n;
+
+    trig_span_md05_coords(p_spn, tlr, &x, &h, &dx, &dh);
+    o = p_spn->o;
+    for (n = p_spn->len; n > 0; n--, o++)
+    {
+        ubyte tex;
+
+        tex = m[(h << 8) | ((x >> 32) & 0xFF)];
+        *o = f[(x & 0xFF00) | tex];
+        x += dx;
+        h += dh + (x < dx);
+    }
+}
+
+#if defined(LB_TRIG_HAVE_X86_SIMD)
+/** Takes lower dwords of 64-bit lanes from two vectors, in lanes order.
+ */
+__attribute__((target("avx2")))
+static inline __m256i trig_lo32_of_64_avx2(__m256i a, __m256i b)
+{
+    const __m256i perm = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    a = _mm256_permutevar8x32_epi32(a, perm);
+    b = _mm256_permutevar8x32_epi32(b, perm);
+    return _mm256_permute2x128_si256(a, b, 0x20);
+}
+
+__attribute__((target("avx2")))
+static void trig_span_md05_avx2(const struct TrigSpan *p_spn,
+  const struct TrigLocalRend *tlr, const ubyte *m, const ubyte *f)
+{
+    const __m256i bias = _mm256_set1_epi64x((s64)0x8000000000000000ULL);
+    const __m256i all = _mm256_set1_epi32(-1);
+    u64 x_arr[8], h_arr[8];
+    __m256i x0, x1, h0, h1, dx8, dh8, dx8_biased;
+    u64 x, dx, dx8_scl;
+    ubyte h, dh, dh8_scl;
+    ubyte *o;
+    long n;
+    int k;
+
+    trig_span_md05_coords(p_spn, tlr, &x, &h, &dx, &dh);
+    // State of each lane, and 8 steps of the 72-bit accumulator
+    dx8_scl = 0;
+    dh8_scl = 0;
+    for (k = 0; k < 8; k++)
+    {
+        x_arr[k] = x;
+        h_arr[k] = h;
+        x += dx;
+        h += dh + (x < dx);
+        dx8_scl += dx;
+        dh8_scl += dh + (dx8_scl < dx);
+    }
+    x0 = _mm256_loadu_si256((const __m256i *)&x_arr[0]);
+    x1 = _mm256_loadu_si256((const __m256i *)&x_arr[4]);
+    h0 = _mm256_loadu_si256((const __m256i *)&h_arr[0]);
+    h1 = _mm256_loadu_si256((const __m256i *)&h_arr[4]);
+    dx8 = _mm256_set1_epi64x(dx8_scl);
+    dh8 = _mm256_set1_epi64x(dh8_scl);
+    dx8_biased = _mm256_xor_si256(dx8, bias);
+
+    o = p_spn->o;
+    for (n = p_spn->len; n >= 8; n -= 8, o += 8)
+    {
+        __m256i idx0, idx1, idx, shd, tex, px;
+
+        idx0 = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(h0, _mm256_set1_epi64x(0xFF)), 8),
+          _mm256_and_si256(_mm256_srli_epi64(x0, 32), _mm256_set1_epi64x(0xFF)));
+        idx1 = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(h1, _mm256_set1_epi64x(0xFF)), 8),
+          _mm256_and_si256(_mm256_srli_epi64(x1, 32), _mm256_set1_epi64x(0xFF)));
+        idx = trig_lo32_of_64_avx2(idx0, idx1);
+        shd = _mm256_and_si256(trig_lo32_of_64_avx2(x0, x1), _mm256_set1_epi32(0xFF00));
+        tex = trig_gather8_avx2(m, idx, all);
+        px = trig_gather8_avx2(f, _mm256_or_si256(shd, tex), all);
+        _mm_storel_epi64((__m128i *)o, trig_pack8_avx2(px));
+
+        // Add with carry out of the lower 64 bits; carry mask is -1, so subtract it
+        x0 = _mm256_add_epi64(x0, dx8);
+        x1 = _mm256_add_epi64(x1, dx8);
+        h0 = _mm256_sub_epi64(_mm256_add_epi64(h0, dh8),
+          _mm256_cmpgt_epi64(dx8_biased, _mm256_xor_si256(x0, bias)));
+        h1 = _mm256_sub_epi64(_mm256_add_epi64(h1, dh8),
+          _mm256_cmpgt_epi64(dx8_biased, _mm256_xor_si256(x1, bias)));
+    }
+    _mm256_storeu_si256((__m256i *)&x_arr[0], x0);
+    _mm256_storeu_si256((__m256i *)&h_arr[0], h0);
+    x = x_arr[0];
+    h = h_arr[0];
+    for (; n > 0; n--, o++)
+    {
+        ubyte tex;
+
+        tex = m[(h << 8) | ((x >> 32) & 0xFF)];
+        *o = f[(x & 0xFF00) | tex];
+        x += dx;
+        h += dh + (x < dx);
+    }
+}
+#endif
+
 void trig_render_md00(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
@@ -189,7 +644,6 @@ void trig_render_md02(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
     ubyte *m;
-    long lsh_var_54;
 
     m = vec_map;
     pp = polyscans;
@@ -197,83 +651,13 @@ void trig_render_md02(struct TrigLocalRend *tlr)
         LOGERR("global arrays not set: 0x%p 0x%p", m, pp);
         return;
     }
-    lsh_var_54 = tlr->var_54 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pX, pY;
-        long pU;
-        ushort colS;
-        ubyte *o;
-
-        pX = pp->X >> 16;
-        pY = pp->Y >> 16;
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-
-        if (pX < 0)
-        {
-            ushort colL, colH;
-            ulong factorA;
-            long mX;
-
-            if (pY <= 0)
-                continue;
-            mX = tlr->var_54 * (-pX);
-            factorA = __ROL4__(pp->V + mX, 16);
-            colH = factorA;
-            mX = tlr->var_48 * (-pX);
-            pU = (factorA & 0xFFFF0000) | ((pp->U + mX) & 0xFFFF);
-            colL = (pp->U + mX) >> 16;
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-            pX = (pp->U + mX) >> 8;
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            short colL, colH;
-
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-            if (pY <= pX)
-                continue;
-            pY = pY - pX;
-            o += pX;
-            pU = __ROL4__(pp->V, 16);
-            colH = pU;
-            pU = (pU & 0xFFFF0000) | (pp->U & 0xFFFF);
-            colL = pp->U >> 16;
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pY > 0; pY--, o++)
-        {
-            short colL, colH;
-            TbBool pU_carry;
-
-            *o = m[colS];
-
-            pU_carry = __CFADDS__(tlr->var_48, pU);
-            pU = (pU & 0xFFFF0000) | ((tlr->var_48 + pU) & 0xFFFF);
-            colL = (tlr->var_48 >> 16) + pU_carry + colS;
-
-            pU_carry = __CFADDL__(lsh_var_54, pU);
-            pU = lsh_var_54 + pU;
-            colH = (tlr->var_54 >> 16) + pU_carry + (colS >> 8);
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-    }
+    trig_render_spans(tlr, pp, m, TrSM_Tex);
 }
 
 void trig_render_md03(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
     ubyte *m;
-    long lsh_var_54;
 
     m = vec_map;
     pp = polyscans;
@@ -281,75 +665,7 @@ void trig_render_md03(struct TrigLocalRend *tlr)
         LOGERR("global arrays not set: 0x%p 0x%p", m, pp);
         return;
     }
-    lsh_var_54 = tlr->var_54 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pX, pY;
-        long pU;
-        ulong factorA;
-        ushort colS;
-        ubyte *o;
-
-        pX = pp->X >> 16;
-        pY = pp->Y >> 16;
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-
-        if (pX < 0)
-        {
-            short colL, colH;
-            long mX;
-
-            if (pY <= 0)
-                continue;
-            mX = tlr->var_54 * (-pX);
-            factorA = __ROL4__(pp->V + mX, 16);
-            colH = factorA;
-            mX = tlr->var_48 * (-pX);
-            pU = (factorA & 0xFFFF0000) | ((pp->U + mX) & 0xFFFF);
-            colL = (pp->U + mX) >> 16;
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            short colL, colH;
-
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-            if (pY <= pX)
-                continue;
-            pY = pY - pX;
-            o += pX;
-            pU = __ROL4__(pp->V, 16);
-            colH = pU;
-            pU = (pU & 0xFFFF0000) | ((pp->U) & 0xFFFF);
-            colL = (pp->U) >> 16;
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pY > 0; pY--, o++)
-        {
-            short colL, colH;
-            TbBool pU_carry;
-
-            if (m[colS] != 0)
-                *o = m[colS];
-
-            pU_carry = __CFADDS__(tlr->var_48, pU);
-            pU = (pU & 0xFFFF0000) | ((tlr->var_48 + pU) & 0xFFFF);
-            colL = (tlr->var_48 >> 16) + pU_carry + colS;
-            pU_carry = __CFADDL__(lsh_var_54, pU);
-            pU = lsh_var_54 + pU;
-            colH = (tlr->var_54 >> 16) + pU_carry + (colS >> 8);
-
-            colS = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-    }
+    trig_render_spans(tlr, pp, m, TrSM_TexKey);
 }
 
 /**
@@ -437,9 +753,6 @@ void trig_render_md05(struct TrigLocalRend *tlr)
     struct PolyPoint *pp;
     ubyte *m;
     ubyte *f;
-    long lsh_var_54;
-    long lsh_var_60;
-    long lvr_var_54;
 
     m = vec_map;
     f = pixmap.fade_table;
@@ -448,101 +761,22 @@ void trig_render_md05(struct TrigLocalRend *tlr)
         LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
         return;
     }
-
-    {
-        ulong factorA, factorB, factorC;
-        factorC = tlr->var_48;
-        // original code used unsigned compare here, making the condition always false
-        //if (tlr->var_60 < 0) factorC--;
-        factorC = __ROL4__(factorC, 16);
-        factorA = __ROL4__(tlr->var_54, 16);
-        factorB = ((ulong)tlr->var_60) >> 8;
-        lsh_var_54 = (factorC & 0xFFFF0000) | (factorB & 0xFFFF);
-        lsh_var_60 = (factorA & 0xFFFFFF00) | (factorC & 0xFF);
-        lvr_var_54 = (factorA & 0xFF);
-    }
+    if (trig_span_kernel == TrSK_Unknown)
+        trig_span_kernel_select();
 
     for (; tlr->var_44; tlr->var_44--, pp++)
     {
-        long pX, pY;
-        long rfactA, rfactB;
-        ushort colM;
-        ubyte *o;
-        ubyte *o_ln;
-
-        pX = pp->X >> 16;
-        pY = pp->Y >> 16;
-        o_ln = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-
-        if (pX < 0)
-        {
-            ulong factorA, factorB;
-            ushort colL, colH;
-            long mX;
-
-            if (pY <= 0)
-                continue;
-            mX = tlr->var_48 * (-pX);
-            factorA = __ROL4__(pp->U + mX, 16);
-            mX = tlr->var_54 * (-pX);
-            factorB = __ROL4__(pp->V + mX, 16);
-            mX = tlr->var_60 * (-pX);
-            colL = (pp->S + mX) >> 8;
-            colH = factorB;
-            rfactB = (factorB & 0xFFFF0000) | (factorA & 0xFF);
-            rfactA = (factorA & 0xFFFF0000) | (colL & 0xFFFF);
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            ulong factorA, factorB;
-            ushort colL, colH;
-
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-            if (pY <= pX)
-                continue;
-            pY = pY - pX;
-            o_ln += pX;
-            factorA = __ROL4__(pp->U, 16);
-            factorB = __ROL4__(pp->V, 16);
-            colL = pp->S >> 8;
-            colH = factorB;
-            // Should the high part really be preserved?
-            rfactB = (factorB & 0xFFFF0000) | (factorA & 0xFF);
-            rfactA = (factorA & 0xFFFF0000) | (colL & 0xFFFF);
+        struct TrigSpan spn;
 
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        o = o_ln;
-
-        for (; pY > 0; pY--, o++)
-        {
-            ushort colL, colH;
-            ushort colS;
-            TbBool rfactA_carry;
-            TbBool rfactB_carry;
-
-            colM = (colM & 0xFF00) + (rfactB & 0xFF);
-            colS = (((rfactA >> 8) & 0xFF) << 8) + m[colM];
-
-            rfactA_carry = __CFADDL__(rfactA, lsh_var_54);
-            rfactA = rfactA + lsh_var_54;
-
-            rfactB_carry = __CFADDL__(rfactB + rfactA_carry, lsh_var_60);
-            rfactB = rfactB + lsh_var_60 + rfactA_carry;
-
-            colH = lvr_var_54 + rfactB_carry + (colM >> 8);
-            colL = colM;
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-
-            *o = f[colS];
+        if (!trig_span_prepare(tlr, pp, &spn))
+            continue;
+#if defined(LB_TRIG_HAVE_X86_SIMD)
+        if (trig_span_kernel == TrSK_AVX2) {
+            trig_span_md05_avx2(&spn, tlr, m, f);
+            continue;
         }
+#endif
+        trig_span_md05_scalar(&spn, tlr, m, f);
     }
 }
 
@@ -556,8 +790,6 @@ void trig_render_md06(struct TrigLocalRend *tlr)
     struct PolyPoint *pp;
     ubyte *m;
     ubyte *f;
-    long lsh_var_54;
-    long lsh_var_60;
 
     m = vec_map;
     f = pixmap.fade_table;
@@ -566,101 +798,7 @@ void trig_render_md06(struct TrigLocalRend *tlr)
         LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
         return;
     }
-    lsh_var_54 = tlr->var_54 << 16;
-    lsh_var_60 = tlr->var_60 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        ubyte *o;
-        short pXa, pYa;
-        long factorA;
-        long pY;
-        ulong factorB;
-        ushort colM;
-
-        pXa = (pp->X >> 16);
-        pYa = (pp->Y >> 16);
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-
-        if (pXa < 0)
-        {
-            ushort colL, colH;
-            ushort pXMa;
-            long pXMb;
-            ulong mX;
-
-            if (pYa <= 0)
-                continue;
-            pXMa = (ushort)-pXa;
-            pXMb = pXMa;
-            factorA = __ROL4__(pp->V + tlr->var_54 * pXMa, 16);
-            colH = factorA;
-            mX = pp->U + tlr->var_48 * pXMa;
-            factorA = (factorA & 0xFFFF0000) | (mX & 0xFFFF);
-            pXa = mX >> 8;
-            colL = (pXa >> 8);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-
-            factorB = __ROL4__(pp->S + tlr->var_60 * pXMb, 16);
-            pXa = (pXa & 0xFFFF00FF) | ((factorB & 0xFF) << 8);
-            factorB = (factorB & 0xFFFF0000) | (pYa & 0xFFFF);
-            pXa = (pXa & 0xFFFF);
-            pY = factorB & 0xFFFF;
-            if (pY > vec_window_width)
-                pY = vec_window_width;
-        }
-        else
-        {
-            ushort colL, colH;
-            ubyte pLa_overflow;
-            short pLa;
-
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            pLa_overflow = __OFSUBS__(pYa, pXa);
-            pLa = pYa - pXa;
-            if (((pLa < 0) ^ pLa_overflow) | (pLa == 0))
-                continue;
-
-            o += pXa;
-            colL = (pp->U >> 16);
-            factorA = __ROL4__(pp->V, 16);
-            colH = factorA;
-            factorB = __ROL4__(pp->S, 16);
-            factorA = (factorA & 0xFFFF0000) | (pp->U & 0xFFFF);
-            pXa = (pXa & 0xFFFF00FF) | ((factorB & 0xFF) << 8);
-            factorB = (factorB & 0xFFFF0000) | (pLa & 0xFFFF);
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-            pY = factorB & 0xFFFF;
-        }
-
-        for (; (pY & 0xFFFF) > 0; pY--, o++)
-        {
-            ushort colL, colH;
-            ubyte fct_carry;
-
-            pXa = (pXa & 0xFF00) | (m[colM] & 0xFF);
-            if (pXa & 0xFF)
-                *o = f[pXa];
-
-            fct_carry = __CFADDS__(tlr->var_48, factorA);
-            factorA = (factorA & 0xFFFF0000) | ((tlr->var_48 + factorA) & 0xFFFF);
-            colL = (tlr->var_48 >> 16) + fct_carry + colM;
-            fct_carry = __CFADDL__(lsh_var_54, factorA);
-            factorA += lsh_var_54;
-            colH = (tlr->var_54 >> 16) + fct_carry + (colM >> 8);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-
-            factorB = (factorB & 0xFFFF0000) | (pY & 0xFFFF);
-            fct_carry = __CFADDL__(lsh_var_60, factorB);
-            factorB += lsh_var_60;
-            pXa = (((pXa >> 8) + (tlr->var_60 >> 16) + fct_carry) << 8) | (pXa & 0xFF);
-            pY += lsh_var_60; // Very alarming. Bug, maybe?
-        }
-    }
+    trig_render_spans(tlr, pp, m, TrSM_TexFadeKey);
 }
 
 void trig_render_md07(struct TrigLocalRend *tlr)
@@ -772,197 +910,19 @@ void trig_render_md08(struct TrigLocalRend *tlr)
         long pYa;
         ushort colM;
         ubyte *o;
-        long factorA;
-
-        pXa = (pp->X >> 16);
-        pYa = (pp->Y >> 16);
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-        if ( (pXa & 0x8000u) != 0 )
-        {
-            ushort colL, colH;
-            ulong factorB, factorC;
-            long pXm;
-
-            if ( (short)pYa <= 0 )
-                continue;
-            pXm = (ushort)-(short)pXa;
-            factorA = __ROL4__(pp->V + tlr->var_54 * pXm, 16);
-            colH = factorA;
-            factorB = pp->U + tlr->var_48 * pXm;
-            factorA = (factorA & 0xFFFF0000) + (factorB & 0xFFFF);
-            factorC = factorB >> 8;
-            colL = ((factorC >> 8) & 0xFF);
-            if (pYa > vec_window_width)
-              pYa = vec_window_width;
-            pXa = (ushort)factorC;
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            ushort colL, colH;
-
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            if (pYa <= pXa)
-                continue;
-            pYa -= pXa;
-            o += pXa;
-            factorA = __ROL4__(pp->V, 16);
-            colH = factorA;
-            factorA = (factorA & 0xFFFF0000) + (pp->U & 0xFFFF);
-            colL = ((pp->U >> 16) & 0xFF);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pYa > 0; pYa--, o++)
-        {
-            ushort colL, colH;
-            ushort colS;
-            ubyte factorA_carry;
-
-            colS = (vec_colour << 8) + m[colM];
-            factorA_carry = __CFADDS__(tlr->var_48, factorA);
-            factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
-            colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
-            if (colS & 0xFF)
-                *o = f[colS];
-            factorA_carry = __CFADDL__(lsh_var_54, factorA);
-            factorA += lsh_var_54;
-            colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-    }
-}
-
-void trig_render_md09(struct TrigLocalRend *tlr)
-{
-    struct PolyPoint *pp;
-    ubyte *m;
-    ubyte *f;
-    long lsh_var_54;
-
-    m = vec_map;
-    f = pixmap.fade_table;
-    pp = polyscans;
-    if ((m == NULL) || (f == NULL) || (pp == NULL)) {
-        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
-        return;
-    }
-    lsh_var_54 = tlr->var_54 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pXa, pYa;
-        long pXm;
-        long factorA;
-        ushort colM;
-        ubyte *o;
-
-        pXa = (pp->X >> 16);
-        pYa = (pp->Y >> 16);
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-        if (pXa < 0)
-        {
-            ushort colL, colH;
-            ulong factorB, factorC;
-
-            if (pYa <= 0)
-                continue;
-            pXm = (ushort)-pXa;
-            factorA = __ROL4__(pp->V + tlr->var_54 * pXm, 16);
-            colH = factorA;
-            factorB = pp->U + tlr->var_48 * pXm;
-            factorA = (factorA & 0xFFFF0000) + (factorB & 0xFFFF);
-            factorC = factorB >> 8;
-            colL = ((factorC >> 8) & 0xFF);
-            if (pYa > vec_window_width)
-              pYa = vec_window_width;
-            pXa = (ushort)factorC;
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            ushort colL, colH;
-
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            if (pYa <= pXa)
-                continue;
-            pYa -= pXa;
-            o += pXa;
-            factorA = __ROL4__(pp->V, 16);
-            colH = factorA;
-            factorA = (factorA & 0xFFFF0000) + (pp->U & 0xFFFF);
-            colL = ((pp->U >> 16) & 0xFF);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pYa > 0; pYa--, o++)
-        {
-            ushort colL, colH;
-            ushort colS;
-            ubyte factorA_carry;
-
-            colS = m[colM] << 8;
-            factorA_carry = __CFADDS__(tlr->var_48, factorA);
-            factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
-            colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
-            if ((colS >> 8) & 0xFF) {
-                colS = (colS & 0xFF00) | (*o);
-                *o = f[colS];
-            }
-            factorA_carry = __CFADDL__(lsh_var_54, factorA);
-            factorA += lsh_var_54;
-            colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-    }
-}
-
-void trig_render_md10(struct TrigLocalRend *tlr)
-{
-    struct PolyPoint *pp;
-    ubyte *m;
-    ubyte *f;
-    long lsh_var_54;
-
-    m = vec_map;
-    f = pixmap.fade_table;
-    pp = polyscans;
-    if ((m == NULL) || (f == NULL) || (pp == NULL)) {
-        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
-        return;
-    }
-    lsh_var_54 = tlr->var_54 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pXa;
-        short pYa;
-        ulong factorB;
-        long factorA;
-        ulong factorC;
-        ushort colM;
-        ubyte *o;
+        long factorA;
 
         pXa = (pp->X >> 16);
         pYa = (pp->Y >> 16);
         o = &tlr->var_24[vec_screen_width];
         tlr->var_24 += vec_screen_width;
-        if (pXa < 0)
+        if ( (pXa & 0x8000u) != 0 )
         {
             ushort colL, colH;
+            ulong factorB, factorC;
             long pXm;
 
-            if (pYa <= 0)
+            if ( (short)pYa <= 0 )
                 continue;
             pXm = (ushort)-(short)pXa;
             factorA = __ROL4__(pp->V + tlr->var_54 * pXm, 16);
@@ -1001,13 +961,12 @@ void trig_render_md10(struct TrigLocalRend *tlr)
             ushort colS;
             ubyte factorA_carry;
 
-            if (m[colM]) {
-                colS = (vec_colour << 8) | (*o);
-                *o = f[colS];
-            }
+            colS = (vec_colour << 8) + m[colM];
             factorA_carry = __CFADDS__(tlr->var_48, factorA);
             factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
             colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
+            if (colS & 0xFF)
+                *o = f[colS];
             factorA_carry = __CFADDL__(lsh_var_54, factorA);
             factorA += lsh_var_54;
             colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
@@ -1017,26 +976,25 @@ void trig_render_md10(struct TrigLocalRend *tlr)
     }
 }
 
-void trig_render_md12(struct TrigLocalRend *tlr)
+void trig_render_md09(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
     ubyte *m;
-    ubyte *g;
+    ubyte *f;
     long lsh_var_54;
 
     m = vec_map;
-    g = pixmap.ghost_table;
+    f = pixmap.fade_table;
     pp = polyscans;
-    if ((m == NULL) || (g == NULL) || (pp == NULL)) {
-        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, g, pp);
+    if ((m == NULL) || (f == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
         return;
     }
     lsh_var_54 = tlr->var_54 << 16;
 
     for (; tlr->var_44; tlr->var_44--, pp++)
     {
-        long pXa;
-        short pYa;
+        short pXa, pYa;
         long pXm;
         long factorA;
         ushort colM;
@@ -1046,23 +1004,23 @@ void trig_render_md12(struct TrigLocalRend *tlr)
         pYa = (pp->Y >> 16);
         o = &tlr->var_24[vec_screen_width];
         tlr->var_24 += vec_screen_width;
-        if ( (pXa & 0x8000u) != 0 )
+        if (pXa < 0)
         {
             ushort colL, colH;
             ulong factorB, factorC;
 
-            if ( (short)pYa <= 0 )
+            if (pYa <= 0)
                 continue;
-            pXm = (ushort)-(short)pXa;
+            pXm = (ushort)-pXa;
             factorA = __ROL4__(pp->V + tlr->var_54 * pXm, 16);
             colH = factorA;
-            factorC = pp->U + tlr->var_48 * pXm;
-            factorA = (factorA & 0xFFFF0000) + (factorC & 0xFFFF);
-            factorB = factorC >> 8;
-            colL = ((factorB >> 8) & 0xFF);
+            factorB = pp->U + tlr->var_48 * pXm;
+            factorA = (factorA & 0xFFFF0000) + (factorB & 0xFFFF);
+            factorC = factorB >> 8;
+            colL = ((factorC >> 8) & 0xFF);
             if (pYa > vec_window_width)
               pYa = vec_window_width;
-            pXa = (ushort)factorB;
+            pXa = (ushort)factorC;
 
             colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
         }
@@ -1090,13 +1048,16 @@ void trig_render_md12(struct TrigLocalRend *tlr)
             ushort colS;
             ubyte factorA_carry;
 
-            colS = (m[colM] << 8) | vec_colour;
+            colS = m[colM] << 8;
             factorA_carry = __CFADDS__(tlr->var_48, factorA);
             factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
             colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
+            if ((colS >> 8) & 0xFF) {
+                colS = (colS & 0xFF00) | (*o);
+                *o = f[colS];
+            }
             factorA_carry = __CFADDL__(lsh_var_54, factorA);
             factorA += lsh_var_54;
-            *o = g[colS];
             colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
 
             colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
@@ -1104,27 +1065,29 @@ void trig_render_md12(struct TrigLocalRend *tlr)
     }
 }
 
-void trig_render_md13(struct TrigLocalRend *tlr)
+void trig_render_md10(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
     ubyte *m;
-    ubyte *g;
+    ubyte *f;
     long lsh_var_54;
 
     m = vec_map;
-    g = pixmap.ghost_table;
+    f = pixmap.fade_table;
     pp = polyscans;
-    if ((m == NULL) || (g == NULL) || (pp == NULL)) {
-        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, g, pp);
+    if ((m == NULL) || (f == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, f, pp);
         return;
     }
     lsh_var_54 = tlr->var_54 << 16;
 
     for (; tlr->var_44; tlr->var_44--, pp++)
     {
-        short pXa, pYa;
-        long pXm;
+        short pXa;
+        short pYa;
+        ulong factorB;
         long factorA;
+        ulong factorC;
         ushort colM;
         ubyte *o;
 
@@ -1135,9 +1098,9 @@ void trig_render_md13(struct TrigLocalRend *tlr)
         if (pXa < 0)
         {
             ushort colL, colH;
-            ulong factorB, factorC;
+            long pXm;
 
-            if ( (short)pYa <= 0 )
+            if (pYa <= 0)
                 continue;
             pXm = (ushort)-(short)pXa;
             factorA = __ROL4__(pp->V + tlr->var_54 * pXm, 16);
@@ -1176,13 +1139,15 @@ void trig_render_md13(struct TrigLocalRend *tlr)
             ushort colS;
             ubyte factorA_carry;
 
-            colS = m[colM] | (vec_colour << 8);
+            if (m[colM]) {
+                colS = (vec_colour << 8) | (*o);
+                *o = f[colS];
+            }
             factorA_carry = __CFADDS__(tlr->var_48, factorA);
             factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
             colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
             factorA_carry = __CFADDL__(lsh_var_54, factorA);
             factorA += lsh_var_54;
-            *o = g[colS];
             colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
 
             colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
@@ -1190,6 +1155,38 @@ void trig_render_md13(struct TrigLocalRend *tlr)
     }
 }
 
+void trig_render_md12(struct TrigLocalRend *tlr)
+{
+    struct PolyPoint *pp;
+    ubyte *m;
+    ubyte *g;
+
+    m = vec_map;
+    g = pixmap.ghost_table;
+    pp = polyscans;
+    if ((m == NULL) || (g == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, g, pp);
+        return;
+    }
+    trig_render_spans(tlr, pp, m, TrSM_TexGhostCol);
+}
+
+void trig_render_md13(struct TrigLocalRend *tlr)
+{
+    struct PolyPoint *pp;
+    ubyte *m;
+    ubyte *g;
+
+    m = vec_map;
+    g = pixmap.ghost_table;
+    pp = polyscans;
+    if ((m == NULL) || (g == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p", m, g, pp);
+        return;
+    }
+    trig_render_spans(tlr, pp, m, TrSM_ColGhostTex);
+}
+
 void trig_render_md14(struct TrigLocalRend *tlr)
 {
     struct PolyPoint *pp;
@@ -1614,92 +1611,16 @@ void trig_render_md20(struct TrigLocalRend *tlr)
     ubyte *m;
     ubyte *g;
     ubyte *f;
-    long lsh_var_54;
-    long lsh_var_60;
 
     m = vec_map;
     g = pixmap.ghost_table;
     f = pixmap.fade_table;
     pp = polyscans;
-    lsh_var_54 = tlr->var_54 << 16;
-    lsh_var_60 = tlr->var_60 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pXa, pYa;
-        long pXMa;
-        long pXMb;
-        long factorA;
-        long factorC;
-        ushort colM;
-        ubyte *o;
-
-        pXa = (pp->X >> 16);
-        pYa = (pp->Y >> 16);
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-        if (pXa < 0)
-        {
-            ushort colL, colH;
-            ulong factorB;
-
-            if (pYa <= 0)
-                continue;
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            pXMa = (ushort)-pXa;
-            pXMb = pXMa;
-            factorA = __ROL4__(pp->V + tlr->var_54 * pXMa, 16);
-            colH = factorA;
-            factorB = pp->U + tlr->var_48 * pXMa;
-            factorA = (factorA & 0xFFFF0000) + (factorB & 0xFFFF);
-            pXa = factorB >> 8;
-            colL = ((pXa >> 8) & 0xFF);
-            factorC = __ROL4__(pp->S + tlr->var_60 * pXMb, 16);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            ushort colL, colH;
-
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            if (pYa <= pXa)
-                continue;
-            pYa -= pXa;
-            o += pXa;
-            factorA = __ROL4__(pp->V, 16);
-            colH = factorA;
-            factorA = (factorA & 0xFFFF0000) + (pp->U & 0xFFFF);
-            colL = ((pp->U >> 16) & 0xFF);
-            factorC = __ROL4__(pp->S, 16);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pYa > 0; pYa--, o++)
-        {
-            ushort colL, colH;
-            ushort colS;
-            ubyte factorA_carry;
-
-            factorA_carry = __CFADDS__(tlr->var_48, factorA);
-            factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
-            colS = ((factorC & 0xFF) << 8) + m[colM];
-            colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
-            factorA_carry = __CFADDL__(lsh_var_54, factorA);
-            factorA += lsh_var_54;
-            colS = ((f[colS] & 0xFF) << 8) + *o;
-            colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
-            factorA_carry = __CFADDL__(lsh_var_60, factorC);
-            factorC += lsh_var_60;
-            *o = g[colS];
-            factorC = (factorC & 0xFFFFFF00) | (((tlr->var_60 >> 16) + factorA_carry + factorC) & 0xFF);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
+    if ((m == NULL) || (g == NULL) || (f == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p 0x%p", m, g, f, pp);
+        return;
     }
+    trig_render_spans(tlr, pp, m, TrSM_TexFadeGhostDst);
 }
 
 void trig_render_md21(struct TrigLocalRend *tlr)
@@ -1708,92 +1629,16 @@ void trig_render_md21(struct TrigLocalRend *tlr)
     ubyte *m;
     ubyte *g;
     ubyte *f;
-    long lsh_var_54;
-    long lsh_var_60;
 
     m = vec_map;
     g = pixmap.ghost_table;
     f = pixmap.fade_table;
     pp = polyscans;
-    lsh_var_54 = tlr->var_54 << 16;
-    lsh_var_60 = tlr->var_60 << 16;
-
-    for (; tlr->var_44; tlr->var_44--, pp++)
-    {
-        short pXa, pYa;
-        ushort colM;
-        ubyte *o;
-        long factorA, factorC;
-
-        pXa = (pp->X >> 16);
-        pYa = (pp->Y >> 16);
-        o = &tlr->var_24[vec_screen_width];
-        tlr->var_24 += vec_screen_width;
-        if (pXa < 0)
-        {
-            ushort colL, colH;
-            long pXMa;
-            long pXMb;
-            ulong factorB;
-
-            if (pYa <= 0)
-                continue;
-            if (pYa > vec_window_width)
-              pYa = vec_window_width;
-            pXMa = (ushort)-pXa;
-            pXMb = pXMa;
-            factorA = __ROL4__(pp->V + tlr->var_54 * pXMa, 16);
-            colH = factorA;
-            factorB = pp->U + tlr->var_48 * pXMa;
-            factorA = (factorA & 0xFFFF0000) + (factorB & 0xFFFF);
-            pXa = factorB >> 8;
-            colL = ((pXa >> 8) & 0xFF);
-            factorC = __ROL4__(pp->S + tlr->var_60 * pXMb, 16);
-            pXa = (pXa & 0xFFFF);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-        else
-        {
-            ushort colL, colH;
-
-            if (pYa > vec_window_width)
-                pYa = vec_window_width;
-            if (pYa <= pXa)
-                continue;
-            pYa -= pXa;
-            o += pXa;
-            factorA = __ROL4__(pp->V, 16);
-            colH = factorA;
-            factorA = (factorA & 0xFFFF0000) + (pp->U & 0xFFFF);
-            colL = ((pp->U >> 16) & 0xFF);
-            factorC = __ROL4__(pp->S, 16);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
-
-        for (; pYa > 0; pYa--, o++)
-        {
-            ushort colL, colH;
-            ushort colS;
-            ubyte factorA_carry;
-
-            factorA_carry = __CFADDS__(tlr->var_48, factorA);
-            factorA = (factorA & 0xFFFF0000) + ((tlr->var_48 + factorA) & 0xFFFF);
-            colL = ((tlr->var_48 >> 16) & 0xFF) + factorA_carry + colM;
-            colS = ((factorC & 0xFF) << 8) + (m[colM] & 0xFF);
-            colS = (((*o) & 0xFF) << 8) + (f[colS] & 0xFF);
-            factorA_carry = __CFADDL__(lsh_var_54, factorA);
-            factorA += lsh_var_54;
-            colH = (colM >> 8) + ((tlr->var_54 >> 16) & 0xFF) + factorA_carry;
-            factorA_carry = __CFADDL__(lsh_var_60, factorC);
-            factorC += lsh_var_60;
-            *o = g[colS];
-            factorC = (factorC & 0xFFFFFF00) | (((tlr->var_60 >> 16) + factorA_carry + factorC) & 0xFF);
-
-            colM = ((colH & 0xFF) << 8) + (colL & 0xFF);
-        }
+    if ((m == NULL) || (g == NULL) || (f == NULL) || (pp == NULL)) {
+        LOGERR("global arrays not set: 0x%p 0x%p 0x%p 0x%p", m, g, f, pp);
+        return;
     }
+    trig_render_spans(tlr, pp, m, TrSM_DstGhostTexFade);
 }
 
 void trig_render_md22(struct TrigLocalRend *tlr)
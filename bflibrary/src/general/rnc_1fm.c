@@ -19,11 +19,18 @@
 /******************************************************************************/
 #include "rnc_1fm.h"
 
+#include <string.h>
 #include "bftypes.h"
 #include "bfendian.h"
 #include "bfmemory.h"
 #include "bfmemut.h"
 
+/** Amount of bits resolved in one step by Huffman lookup table.
+ * Codes up to this length are decoded by single table access,
+ * longer ones fall back to scanning the table of codes.
+ */
+#define HUF_LOOKUP_BITS 9
+
 typedef struct {
     unsigned long bitbuf;           /* holds between 16 and 32 bits */
     int bitcount;               /* how many bits does bitbuf hold? */
@@ -36,19 +43,23 @@ typedef struct {
     int codelen;
     int value;
     } table[32];
+    /* index of table entry plus one, for each combination of lowest
+     * HUF_LOOKUP_BITS bits of the stream; zero if the code is longer */
+    unsigned char lookup[1 << HUF_LOOKUP_BITS];
 } huf_table;
 
 static void read_huftable (huf_table *h, bit_stream *bs,
                    unsigned char **p, unsigned char *pend);
+static void build_huflookup (huf_table *h);
 static long huf_read (huf_table *h, bit_stream *bs,
                    unsigned char **p,unsigned char *pend);
 
 static void bitread_init (bit_stream *bs, unsigned char **p, unsigned char *pend);
 static void bitread_fix (bit_stream *bs, unsigned char **p, unsigned char *pend);
-static unsigned long bit_peek (bit_stream *bs, unsigned long mask);
-static void bit_advance (bit_stream *bs, int n,
+static inline unsigned long bit_peek (bit_stream *bs, unsigned long mask);
+static inline void bit_advance (bit_stream *bs, int n,
                    unsigned char **p, unsigned char *pend);
-static unsigned long bit_read (bit_stream *bs, unsigned long mask,
+static inline unsigned long bit_read (bit_stream *bs, unsigned long mask,
                    int n, unsigned char **p, unsigned char *pend);
 
 static unsigned long mirror(unsigned long x, int n);
@@ -118,6 +129,36 @@ static void read_huftable (huf_table *h, bit_stream *bs,
     }
 
     h->num = k;
+    build_huflookup (h);
+}
+
+/** @internal
+ * Fill the lookup table of a Huffman table with codes it has.
+ * Entries are placed in order, so if codes conflict the first one wins,
+ * same as when scanning the table.
+ */
+static void build_huflookup (huf_table *h)
+{
+    int i;
+    unsigned long idx;
+
+    LbMemorySet(h->lookup, 0, sizeof(h->lookup));
+    for (i=0; i<h->num; i++)
+    {
+        unsigned long step;
+
+        if (h->table[i].codelen > HUF_LOOKUP_BITS)
+            continue;
+        // Code with bits above its length can never match
+        if ((h->table[i].code >> h->table[i].codelen) != 0)
+            continue;
+        step = 1 << h->table[i].codelen;
+        for (idx = h->table[i].code; idx < (1 << HUF_LOOKUP_BITS); idx += step)
+        {
+            if (h->lookup[idx] == 0)
+                h->lookup[idx] = i + 1;
+        }
+    }
 }
 
 /** @internal
@@ -129,14 +170,23 @@ static long huf_read (huf_table *h, bit_stream *bs,
     int i;
     unsigned long val;
 
-    for (i=0; i<h->num; i++)
+    // Bit buffer always has at least 16 bits, so peeking is safe
+    i = h->lookup[bit_peek(bs, (1 << HUF_LOOKUP_BITS) - 1)];
+    if (i != 0)
     {
-        unsigned long mask = (1 << h->table[i].codelen) - 1;
-        if (bit_peek(bs, mask) == h->table[i].code)
-            break;
+        i--;
+    }
+    else
+    {
+        for (i=0; i<h->num; i++)
+        {
+            unsigned long mask = (1 << h->table[i].codelen) - 1;
+            if (bit_peek(bs, mask) == h->table[i].code)
+                break;
+        }
+        if (i == h->num)
+            return -1;
     }
-    if (i == h->num)
-        return -1;
     bit_advance (bs, h->table[i].codelen, p, pend);
 
     val = h->table[i].value;
@@ -180,7 +230,7 @@ static void bitread_fix (bit_stream *bs, unsigned char **p, unsigned char *pend)
 /** @internal
  * Returns some bits.
  */
-static unsigned long bit_peek (bit_stream *bs, unsigned long mask)
+static inline unsigned long bit_peek (bit_stream *bs, unsigned long mask)
 {
     return bs->bitbuf & mask;
 }
@@ -189,7 +239,7 @@ static unsigned long bit_peek (bit_stream *bs, unsigned long mask)
  * Advances the bit stream.
  * Checks pend for proper buffer pointers range.
  */
-static void bit_advance (bit_stream *bs, int n, unsigned char **p, unsigned char *pend)
+static inline void bit_advance (bit_stream *bs, int n, unsigned char **p, unsigned char *pend)
 {
     bs->bitbuf >>= n;
     bs->bitcount -= n;
@@ -205,7 +255,7 @@ static void bit_advance (bit_stream *bs, int n, unsigned char **p, unsigned char
 /** @internal
  * Reads some bits in one go (ie the above two routines combined).
  */
-static unsigned long bit_read (bit_stream *bs, unsigned long mask,
+static inline unsigned long bit_read (bit_stream *bs, unsigned long mask,
                    int n, unsigned char **p, unsigned char *pend)
 {
     unsigned long result = bit_peek (bs, mask);
@@ -230,7 +280,10 @@ static unsigned long mirror (unsigned long x, int n) {
     return x;
 }
 
-unsigned short crctab[256];
+/** CRC tables; first one is the classic per-byte table, next ones are
+ * derived from it to allow processing 4 bytes in one step.
+ */
+unsigned short crctab[4][256];
 short crctab_ready=false;
 
 /** @internal
@@ -255,16 +308,31 @@ long rnc_crc(void *data, unsigned long len)
             else
               val = (val >> 1);
           }
-          crctab[i] = val;
+          crctab[0][i] = val;
+      }
+      for (i=0; i<256; i++)
+      {
+          for (j=1; j<4; j++)
+          {
+              val = crctab[j-1][i];
+              crctab[j][i] = (val >> 8) ^ crctab[0][val & 0xFF];
+          }
       }
     crctab_ready=true;
     }
 
     val = 0;
+    while (len >= 4)
+    {
+       val = crctab[3][(p[0] ^ val) & 0xFF] ^ crctab[2][(p[1] ^ (val >> 8)) & 0xFF]
+          ^ crctab[1][p[2]] ^ crctab[0][p[3]];
+       p += 4;
+       len -= 4;
+    }
     while (len--)
     {
        val ^= *p++;
-       val = (val >> 8) ^ crctab[val & 0xFF];
+       val = (val >> 8) ^ crctab[0][val & 0xFF];
     }
     return val;
 }
@@ -313,6 +381,12 @@ long rnc_unpack(void *packed, void *unpacked, unsigned int flags
         if (!(flags&RNC_IGNORE_PACKED_CRC_ERROR)) return RNC_PACKED_CRC_ERROR;
     out_crc = bword(input-6);
 
+    // Tables with no codes, in case the first chunk does not define them
+    raw.num = dist.num = len.num = 0;
+    LbMemorySet(raw.lookup, 0, sizeof(raw.lookup));
+    LbMemorySet(dist.lookup, 0, sizeof(dist.lookup));
+    LbMemorySet(len.lookup, 0, sizeof(len.lookup));
+
     bitread_init (&bs, &input, inputend);
     bit_advance (&bs, 2, &input, inputend);      // discard first two bits
 
@@ -352,6 +426,14 @@ long rnc_unpack(void *packed, void *unpacked, unsigned int flags
             }
         if (length)
         {
+            // Copy whole run at once if it fits within both buffers
+            if ((length <= inputend - input) && (length <= outputend - output))
+            {
+                memcpy(output, input, length);
+                output += length;
+                input += length;
+                length = 0;
+            }
             while (length--)
             {
                 if ((input >= inputend) || (output >= outputend))
@@ -389,6 +471,27 @@ long rnc_unpack(void *packed, void *unpacked, unsigned int flags
         }
         posn += 1;
         length += 2;
+        // Fast copy if both source and destination are within the buffer
+        if ((posn <= output - (unsigned char *)unpacked)
+          && (length <= outputend - output))
+        {
+            if (posn >= 8)
+            {
+                // Source is at least 8 bytes behind, so chunks do not overlap
+                while (length >= 8)
+                {
+                    memcpy(output, output - posn, 8);
+                    output += 8;
+                    length -= 8;
+                }
+            }
+            while (length > 0)
+            {
+                *output = output[-posn];
+                output++;
+                length--;
+            }
+        }
         while (length--)
         {
             if (((output-posn) < (unsigned char *)unpacked)
@@ -18,7 +18,10 @@
  */
 /******************************************************************************/
 #include "bfscrcopy.h"
+
+#include <string.h>
 #include "bfscreen.h"
+#include "bfmemut.h"
 
 void *LbI_XMemCopy(void *dest, void *source, ulong len);
 
@@ -158,4 +161,67 @@ void LbScreenSave(TbPixel *sourceBuf, TbPixel *destBuf, ushort height)
     }
 }
 
+void LbScreenCopyScaled(const TbPixel *sourceBuf, ulong sourceWidth,
+  ulong sourceHeight, ulong sourceScanln, TbPixel *destBuf,
+  ulong destWidth, ulong destHeight, ulong destScanln)
+{
+    static ushort col_map[MAX_SUPPORTED_SCREEN_WIDTH];
+    static ulong col_map_src_width = 0;
+    static ulong col_map_dst_width = 0;
+    const TbPixel *s;
+    TbPixel *d;
+    ulong step_y, pos_y;
+    long prev_y;
+    ulong x, y;
+
+    if ((sourceWidth == 0) || (sourceHeight == 0))
+        return;
+    if (destWidth > MAX_SUPPORTED_SCREEN_WIDTH)
+        destWidth = MAX_SUPPORTED_SCREEN_WIDTH;
+
+    // Source column for each destination pixel, sampled at pixel centres
+    if ((col_map_src_width != sourceWidth) || (col_map_dst_width != destWidth))
+    {
+        ulong step_x, pos_x;
+
+        step_x = (sourceWidth << 16) / destWidth;
+        pos_x = step_x >> 1;
+        for (x = 0; x < destWidth; x++, pos_x += step_x)
+            col_map[x] = pos_x >> 16;
+        col_map_src_width = sourceWidth;
+        col_map_dst_width = destWidth;
+    }
+
+    step_y = (sourceHeight << 16) / destHeight;
+    pos_y = step_y >> 1;
+    prev_y = -1;
+    d = destBuf;
+    for (y = 0; y < destHeight; y++, pos_y += step_y, d += destScanln)
+    {
+        long src_y;
+
+        src_y = pos_y >> 16;
+        if (src_y == prev_y) {
+            LbMemoryCopy(d, d - destScanln, destWidth);
+            continue;
+        }
+        prev_y = src_y;
+        s = sourceBuf + src_y * sourceScanln;
+        if (destWidth == 2 * sourceWidth)
+        {
+            for (x = 0; x < sourceWidth; x++)
+            {
+                ushort px2;
+                px2 = s[x] | (s[x] << 8);
+                memcpy(&d[2 * x], &px2, sizeof(px2));
+            }
+        }
+        else
+        {
+            for (x = 0; x < destWidth; x++)
+                d[x] = s[col_map[x]];
+        }
+    }
+}
+
 /******************************************************************************/
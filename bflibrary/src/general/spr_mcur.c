@@ -20,6 +20,7 @@
 /******************************************************************************/
 #include "bfsprite.h"
 
+#include <stdlib.h>
 #include "insspr.h"
 #include "privbflog.h"
 
@@ -37,10 +38,6 @@ volatile TbBool lbPointerAdvancedDraw = true;
 long cursor_xsteps_array[2*CURSOR_SCALING_XSTEPS];
 long cursor_ysteps_array[2*CURSOR_SCALING_YSTEPS];
 
-// function used for actual drawing
-TbResult LbSpriteDrawUsingScalingUpDataSolidLR(uchar *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const struct TbSprite *sprite);
-
 /******************************************************************************/
 
 void LbCursorSpriteSetScalingWidthClipped(long x, long swidth, long dwidth, long gwidth)
@@ -75,6 +72,127 @@ void LbCursorSpriteSetScalingHeightSimple(long y, long sheight, long dheight)
     LbSpriteSetScalingHeightSimpleArray(cursor_ysteps_array, y, sheight, dheight);
 }
 
+/**
+ * Draws a scaled up sprite on given buffer, with original colours, from left to right.
+ * Requires step arrays for scaling.
+ *
+ * @param outbuf The output buffer.
+ * @param scanline Length of the output buffer scanline.
+ * @param outheight
+ * @param xstep Scaling steps array, x dimension.
+ * @param ystep Scaling steps array, y dimension.
+ * @param sprite The source sprite.
+ * @return Gives 0 on success.
+ */
+static TbResult LbSpriteDrawUsingScalingUpDataSolidLR(ubyte *outbuf, int scanline, int outheight,
+  long *xstep, long *ystep, const TbSprite *sprite)
+{
+    int ystep_delta;
+    unsigned char *sprdata;
+    long *ycurstep;
+
+    LOGDBG("drawing");
+    ystep_delta = 2;
+    if (scanline < 0) {
+        ystep_delta = -2;
+    }
+    sprdata = sprite->Data;
+    ycurstep = ystep;
+
+    int h;
+    for (h=sprite->SHeight; h > 0; h--)
+    {
+        if (ycurstep[1] != 0)
+        {
+            int ycur;
+            int solid_len;
+            TbPixel * out_line;
+            int xdup, ydup;
+            long *xcurstep;
+            ydup = ycurstep[1];
+            if (ycurstep[0]+ydup > outheight)
+                ydup = outheight-ycurstep[0];
+            xcurstep = xstep;
+            TbPixel *out_end;
+            out_end = outbuf;
+            while ( 1 )
+            {
+                long pxlen;
+                pxlen = (signed char)*sprdata;
+                sprdata++;
+                if (pxlen == 0)
+                    break;
+                if (pxlen < 0)
+                {
+                    pxlen = -pxlen;
+                    out_end -= xcurstep[0];
+                    xcurstep += 2 * pxlen;
+                    out_end += xcurstep[0];
+                }
+                else
+                {
+                    TbPixel *out_start;
+                    out_start = out_end;
+                    for(;pxlen > 0; pxlen--)
+                    {
+                        xdup = xcurstep[1];
+                        if (xcurstep[0]+xdup > abs(scanline))
+                            xdup = abs(scanline)-xcurstep[0];
+                        if (xdup > 0)
+                        {
+                            unsigned char pxval;
+                            pxval = *sprdata;
+                            for (;xdup > 0; xdup--)
+                            {
+                                *out_end = pxval;
+                                out_end++;
+                            }
+                        }
+                        sprdata++;
+                        xcurstep += 2;
+                    }
+                    ycur = ydup - 1;
+                    if (ycur > 0)
+                    {
+                        solid_len = out_end - out_start;
+                        out_line = out_start + scanline;
+                        for (;ycur > 0; ycur--)
+                        {
+                            if (solid_len > 0) {
+                                LbPixelBlockCopyForward(out_line, out_start, solid_len);
+                            }
+                            out_line += scanline;
+                        }
+                    }
+                }
+            }
+            outbuf += scanline;
+            ycur = ydup - 1;
+            for (;ycur > 0; ycur--)
+            {
+                outbuf += scanline;
+            }
+        }
+        else
+        {
+            while ( 1 )
+            {
+                long pxlen;
+                pxlen = (signed char)*sprdata;
+                sprdata++;
+                if (pxlen == 0)
+                  break;
+                if (pxlen > 0)
+                {
+                    sprdata += pxlen;
+                }
+            }
+        }
+        ycurstep += ystep_delta;
+    }
+    return 0;
+}
+
 /**
  * Draws the mouse pointer sprite on a display buffer.
  */
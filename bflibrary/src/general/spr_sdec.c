@@ -0,0 +1,516 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file spr_sdec.c
+ *     Sprites drawing with scaling, from decoded sprites cache.
+ * @par Purpose:
+ *     Decodes RLE sprites into uncompressed form once, and draws them scaled
+ *     using the scaling steps arrays, with any pixel blending and direction.
+ * @par Comment:
+ *     Part of 8-bit graphics canvas drawing library.
+ *     Used for drawing sprites on screen.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "bfsprite.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "insspr.h"
+#include "bfmemory.h"
+#include "bfmemut.h"
+#include "privbflog.h"
+
+/******************************************************************************/
+
+/** Amount of hash slots for decoded sprites; needs to be power of 2. */
+#define SPRITE_CACHE_SLOTS 4096
+/** Size of the memory pool storing decoded sprites. */
+#define SPRITE_CACHE_POOL_SIZE (4*1024*1024)
+
+struct SpriteCacheSlot {
+    const TbSprite *Sprite;
+    /** Sprite data pointer at time of decoding, to detect reloads. */
+    TbSpriteData Data;
+    ushort Width;
+    ushort Height;
+    /** Width*Height pixels, followed by Width*Height opaque mask bytes. */
+    ubyte *Pixels;
+};
+
+/** Part of the output line where sprite columns are contiguous.
+ *
+ * The drawing routines move output pointer by the drawn width when passing
+ * sprite pixels, but by difference between steps array positions when
+ * passing transparent pixels. Both give the same result, unless the steps
+ * array was clipped; then the line is split into spans, and each span can
+ * be shifted depending on whether the sprite pixel at break was transparent.
+ */
+struct SpriteScaledSpan {
+    /** Position of leftmost pixel of the span, relative to output buffer. */
+    long X;
+    ushort MapPos;
+    ushort Width;
+    /** Sprite column at end of the span, after which the break happens. */
+    ushort BreakCol;
+    /** Shift of next spans if sprite pixel at the break is not transparent. */
+    short BreakShift;
+};
+
+static struct SpriteCacheSlot sprite_cache_slots[SPRITE_CACHE_SLOTS];
+static ulong sprite_cache_slots_used = 0;
+static ubyte *sprite_cache_pool = NULL;
+static ulong sprite_cache_pool_used = 0;
+/** Separate entry for sprites too large to fit the pool. */
+static struct SpriteCacheSlot sprite_cache_large;
+static ulong sprite_cache_large_size = 0;
+
+/** Sprite column drawn at each pixel of the output line spans. */
+static ushort sprite_scaled_map[SPRITE_SCALING_XSTEPS];
+static struct SpriteScaledSpan sprite_scaled_spans[MAX_SUPPORTED_SPRITE_DIM];
+static ushort sprite_scaled_spans_num;
+
+/** Output line of a span, with sprite pixels already scaled. */
+static TbPixel sprite_scaled_line[SPRITE_SCALING_XSTEPS];
+static ubyte sprite_scaled_mask[SPRITE_SCALING_XSTEPS];
+
+/******************************************************************************/
+
+static void sprite_decode(const TbSprite *sprite, ubyte *pixels, ubyte *opaque)
+{
+    const sbyte *sprdata;
+    int w, h;
+    int y;
+
+    w = sprite->SWidth;
+    h = sprite->SHeight;
+    LbMemorySet(pixels, 0, w * h);
+    LbMemorySet(opaque, 0, w * h);
+    sprdata = (const sbyte *)sprite->Data;
+    for (y = 0; y < h; y++)
+    {
+        int x;
+
+        x = 0;
+        while (1)
+        {
+            int pxlen;
+
+            pxlen = *sprdata++;
+            if (pxlen == 0)
+                break;
+            if (pxlen < 0) {
+                x -= pxlen;
+                continue;
+            }
+            for (; pxlen > 0; pxlen--, x++, sprdata++)
+            {
+                if (x >= w)
+                    continue;
+                pixels[x] = *sprdata;
+                opaque[x] = 0xFF;
+            }
+        }
+        pixels += w;
+        opaque += w;
+    }
+}
+
+static void sprite_cache_flush(void)
+{
+    LOGDBG("flushing %lu sprites, %lu bytes",
+      sprite_cache_slots_used, sprite_cache_pool_used);
+    LbMemorySet(sprite_cache_slots, 0, sizeof(sprite_cache_slots));
+    sprite_cache_slots_used = 0;
+    sprite_cache_pool_used = 0;
+}
+
+static TbBool sprite_cache_slot_valid(const struct SpriteCacheSlot *p_slot,
+  const TbSprite *sprite)
+{
+    return (p_slot->Data == sprite->Data) && (p_slot->Width == sprite->SWidth)
+      && (p_slot->Height == sprite->SHeight);
+}
+
+static ubyte *sprite_cache_get_large(const TbSprite *sprite, ulong size)
+{
+    struct SpriteCacheSlot *p_slot;
+
+    p_slot = &sprite_cache_large;
+    if ((p_slot->Sprite == sprite) && sprite_cache_slot_valid(p_slot, sprite))
+        return p_slot->Pixels;
+    if (sprite_cache_large_size < size)
+    {
+        LbMemoryFree(p_slot->Pixels);
+        p_slot->Pixels = LbMemoryAlloc(size);
+        if (p_slot->Pixels == NULL) {
+            LOGERR("cannot allocate %lu bytes for decoded sprite", size);
+            sprite_cache_large_size = 0;
+            p_slot->Sprite = NULL;
+            return NULL;
+        }
+        sprite_cache_large_size = size;
+    }
+    p_slot->Sprite = sprite;
+    p_slot->Data = sprite->Data;
+    p_slot->Width = sprite->SWidth;
+    p_slot->Height = sprite->SHeight;
+    sprite_decode(sprite, p_slot->Pixels, p_slot->Pixels + size / 2);
+    return p_slot->Pixels;
+}
+
+/** Gives decoded pixels and opaque mask of given sprite, decoding it if needed.
+ */
+static ubyte *sprite_cache_get(const TbSprite *sprite)
+{
+    struct SpriteCacheSlot *p_slot;
+    ulong size;
+    ulong idx;
+
+    size = 2 * sprite->SWidth * sprite->SHeight;
+    if (size > SPRITE_CACHE_POOL_SIZE / 4)
+        return sprite_cache_get_large(sprite, size);
+
+    if (sprite_cache_pool == NULL)
+    {
+        sprite_cache_pool = LbMemoryAlloc(SPRITE_CACHE_POOL_SIZE);
+        if (sprite_cache_pool == NULL) {
+            LOGERR("cannot allocate %lu bytes for decoded sprites",
+              (ulong)SPRITE_CACHE_POOL_SIZE);
+            return NULL;
+        }
+        sprite_cache_flush();
+    }
+
+    // Sprites are stored in arrays, so consecutive ones get consecutive slots
+    idx = (ulong)sprite / sizeof(TbSprite);
+    idx ^= idx >> 12;
+    while (1)
+    {
+        idx &= (SPRITE_CACHE_SLOTS - 1);
+        p_slot = &sprite_cache_slots[idx];
+        if (p_slot->Sprite == NULL)
+            break;
+        if (p_slot->Sprite == sprite) {
+            if (sprite_cache_slot_valid(p_slot, sprite))
+                return p_slot->Pixels;
+            // Sprite was reloaded; old pixels stay in the pool until flush
+            break;
+        }
+        idx++;
+    }
+
+    if ((sprite_cache_pool_used + size > SPRITE_CACHE_POOL_SIZE) ||
+      (sprite_cache_slots_used >= SPRITE_CACHE_SLOTS * 3 / 4))
+    {
+        sprite_cache_flush();
+        return sprite_cache_get(sprite);
+    }
+
+    if (p_slot->Sprite == NULL)
+        sprite_cache_slots_used++;
+    p_slot->Sprite = sprite;
+    p_slot->Data = sprite->Data;
+    p_slot->Width = sprite->SWidth;
+    p_slot->Height = sprite->SHeight;
+    p_slot->Pixels = sprite_cache_pool + sprite_cache_pool_used;
+    sprite_cache_pool_used += size;
+    sprite_decode(sprite, p_slot->Pixels, p_slot->Pixels + size / 2);
+    return p_slot->Pixels;
+}
+
+void LbSpriteCacheReset(void)
+{
+    LbMemoryFree(sprite_cache_pool);
+    sprite_cache_pool = NULL;
+    sprite_cache_pool_used = 0;
+    LbMemorySet(sprite_cache_slots, 0, sizeof(sprite_cache_slots));
+    sprite_cache_slots_used = 0;
+    LbMemoryFree(sprite_cache_large.Pixels);
+    LbMemorySet(&sprite_cache_large, 0, sizeof(sprite_cache_large));
+    sprite_cache_large_size = 0;
+}
+
+/******************************************************************************/
+
+static void sprite_scaled_span_finish(struct SpriteScaledSpan *p_span,
+  long last_pos, TbBool flip_horiz)
+{
+    if (flip_horiz)
+    {
+        ushort *map_beg, *map_end;
+
+        // Map was filled in drawing order, which is right to left
+        map_beg = &sprite_scaled_map[p_span->MapPos];
+        map_end = map_beg + p_span->Width - 1;
+        for (; map_beg < map_end; map_beg++, map_end--)
+        {
+            ushort col;
+            col = *map_beg;
+            *map_beg = *map_end;
+            *map_end = col;
+        }
+        p_span->X = last_pos + 1;
+    }
+}
+
+/** Prepares spans of the output line, and sprite column for each of their pixels.
+ *
+ * @param xstep Scaling steps array position of the first drawn sprite column.
+ * @param scanwidth Length of the output buffer scanline.
+ * @param flip_horiz Whether the sprite is drawn from right to left.
+ * @param scale_up Whether the steps array was prepared for enlarging.
+ * @param swidth Sprite width.
+ */
+static void sprite_scaled_layout(const long *xstep, int scanwidth,
+  TbBool flip_horiz, TbBool scale_up, int swidth)
+{
+    struct SpriteScaledSpan *p_span;
+    const long *xcurstep;
+    long orig_pos, pos;
+    ulong map_pos;
+    int xstep_delta;
+    int i;
+
+    xstep_delta = flip_horiz ? -2 : 2;
+    if (flip_horiz)
+        orig_pos = xstep[0] + xstep[1] - 1;
+    else
+        orig_pos = xstep[0];
+
+    p_span = &sprite_scaled_spans[0];
+    LbMemorySet(p_span, 0, sizeof(*p_span));
+    sprite_scaled_spans_num = 1;
+    map_pos = 0;
+    pos = 0;
+    xcurstep = xstep;
+    for (i = 0; i < swidth; i++, xcurstep += xstep_delta)
+    {
+        long cur_pos, xdup;
+
+        if (flip_horiz)
+            cur_pos = xcurstep[0] + xcurstep[1] - 1 - orig_pos;
+        else
+            cur_pos = xcurstep[0] - orig_pos;
+        xdup = xcurstep[1];
+        if (scale_up) {
+            if (xcurstep[0] + xdup > scanwidth)
+                xdup = scanwidth - xcurstep[0];
+            if (xdup < 0)
+                xdup = 0;
+        } else {
+            xdup = (xdup > 0) ? 1 : 0;
+        }
+        if (map_pos + xdup > SPRITE_SCALING_XSTEPS)
+            xdup = SPRITE_SCALING_XSTEPS - map_pos;
+
+        if (cur_pos != pos)
+        {
+            p_span->BreakCol = i - 1;
+            p_span->BreakShift = pos - cur_pos;
+            sprite_scaled_span_finish(p_span, pos, flip_horiz);
+            p_span++;
+            sprite_scaled_spans_num++;
+            p_span->X = cur_pos;
+            p_span->MapPos = map_pos;
+            p_span->Width = 0;
+            p_span->BreakCol = 0;
+            p_span->BreakShift = 0;
+        }
+        p_span->Width += xdup;
+        for (; xdup > 0; xdup--)
+        {
+            sprite_scaled_map[map_pos++] = i;
+            if (flip_horiz)
+                cur_pos--;
+            else
+                cur_pos++;
+        }
+        pos = cur_pos;
+    }
+    sprite_scaled_span_finish(p_span, pos, flip_horiz);
+}
+
+/******************************************************************************/
+
+static void sprite_scaled_line_solid(TbPixel *outbuf, int len)
+{
+    const TbPixel *src;
+    const ubyte *msk;
+
+    src = sprite_scaled_line;
+    msk = sprite_scaled_mask;
+    // Select 4 pixels at a time; mask bytes are either 0x00 or 0xFF
+    for (; len >= 4; len -= 4, outbuf += 4, src += 4, msk += 4)
+    {
+        u32 pxsrc, pxmsk, pxdst;
+
+        memcpy(&pxmsk, msk, 4);
+        if (pxmsk == 0)
+            continue;
+        memcpy(&pxsrc, src, 4);
+        if (pxmsk != 0xFFFFFFFF) {
+            memcpy(&pxdst, outbuf, 4);
+            pxsrc = (pxsrc & pxmsk) | (pxdst & ~pxmsk);
+        }
+        memcpy(outbuf, &pxsrc, 4);
+    }
+    for (; len > 0; len--, outbuf++, src++, msk++)
+    {
+        if (*msk != 0)
+            *outbuf = *src;
+    }
+}
+
+static void sprite_scaled_line_trans_src_dst(TbPixel *outbuf, int len,
+  const TbPixel *transmap)
+{
+    const TbPixel *src;
+    const ubyte *msk;
+    int i;
+
+    src = sprite_scaled_line;
+    msk = sprite_scaled_mask;
+    for (i = 0; i < len; i++)
+    {
+        if (msk[i] != 0)
+            outbuf[i] = transmap[(src[i] << 8) | outbuf[i]];
+    }
+}
+
+static void sprite_scaled_line_trans_dst_src(TbPixel *outbuf, int len,
+  const TbPixel *transmap)
+{
+    const TbPixel *src;
+    const ubyte *msk;
+    int i;
+
+    src = sprite_scaled_line;
+    msk = sprite_scaled_mask;
+    for (i = 0; i < len; i++)
+    {
+        if (msk[i] != 0)
+            outbuf[i] = transmap[(outbuf[i] << 8) | src[i]];
+    }
+}
+
+/** Fills the scaled line buffers for given span and sprite row.
+ * @return Gives true if any pixel within the span is not transparent.
+ */
+static TbBool sprite_scaled_line_fill(const struct SpriteScaledSpan *p_span,
+  const ubyte *pixels, const ubyte *opaque, ubyte blend, const TbPixel *table)
+{
+    const ushort *map;
+    ubyte any_opaque;
+    int i;
+
+    map = &sprite_scaled_map[p_span->MapPos];
+    any_opaque = 0;
+    for (i = 0; i < p_span->Width; i++)
+    {
+        sprite_scaled_mask[i] = opaque[map[i]];
+        any_opaque |= sprite_scaled_mask[i];
+    }
+    if (any_opaque == 0)
+        return false;
+    if (blend == SprBl_Remap) {
+        for (i = 0; i < p_span->Width; i++)
+            sprite_scaled_line[i] = table[pixels[map[i]]];
+    } else {
+        for (i = 0; i < p_span->Width; i++)
+            sprite_scaled_line[i] = pixels[map[i]];
+    }
+    return true;
+}
+
+TbResult LbSpriteDrawDecodedUsingScaling(ubyte *outbuf, int scanline, int outheight,
+  long *xstep, long *ystep, TbBool flip_horiz, TbBool scale_up,
+  const TbSprite *sprite, ubyte blend, const TbPixel *table)
+{
+    const ubyte *pixels;
+    const ubyte *opaque;
+    long *ycurstep;
+    int ystep_delta;
+    long lines_drawn;
+    int w, h;
+
+    LOGDBG("drawing");
+    w = sprite->SWidth;
+    h = sprite->SHeight;
+    if ((w == 0) || (h == 0))
+        return Lb_SUCCESS;
+    pixels = sprite_cache_get(sprite);
+    if (pixels == NULL)
+        return Lb_FAIL;
+    opaque = pixels + w * h;
+
+    sprite_scaled_layout(xstep, abs(scanline), flip_horiz, scale_up, w);
+
+    ystep_delta = 2;
+    if (scanline < 0) {
+        ystep_delta = -2;
+    }
+    ycurstep = ystep;
+    lines_drawn = 0;
+    for (; h > 0; h--, ycurstep += ystep_delta, pixels += w, opaque += w)
+    {
+        long shift;
+        int ydup;
+        int i;
+
+        if (ycurstep[1] == 0)
+            continue;
+        if (scale_up) {
+            ydup = ycurstep[1];
+            if (ycurstep[0] + ydup > outheight)
+                ydup = outheight - ycurstep[0];
+            if (ydup <= 0)
+                continue;
+        } else {
+            ydup = 1;
+        }
+
+        shift = 0;
+        for (i = 0; i < sprite_scaled_spans_num; i++)
+        {
+            struct SpriteScaledSpan *p_span;
+            TbPixel *out_line;
+            int k;
+
+            p_span = &sprite_scaled_spans[i];
+            if ((p_span->Width > 0) &&
+              sprite_scaled_line_fill(p_span, pixels, opaque, blend, table))
+            {
+                out_line = outbuf + lines_drawn * scanline + p_span->X + shift;
+                for (k = 0; k < ydup; k++, out_line += scanline)
+                {
+                    switch (blend)
+                    {
+                    case SprBl_TransSrcDst:
+                        sprite_scaled_line_trans_src_dst(out_line, p_span->Width, table);
+                        break;
+                    case SprBl_TransDstSrc:
+                        sprite_scaled_line_trans_dst_src(out_line, p_span->Width, table);
+                        break;
+                    default:
+                        sprite_scaled_line_solid(out_line, p_span->Width);
+                        break;
+                    }
+                }
+            }
+            if (opaque[p_span->BreakCol] != 0)
+                shift += p_span->BreakShift;
+        }
+        lines_drawn += ydup;
+    }
+    return Lb_SUCCESS;
+}
+
+/******************************************************************************/
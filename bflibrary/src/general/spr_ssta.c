@@ -26,16 +26,7 @@
 #include "bfscreen.h"
 #include "privbflog.h"
 
-// The functions below are from standard version of the routine - reused here
-TbResult LbSpriteDrawUsingScalingUpDataTrans1RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap);
-TbResult LbSpriteDrawUsingScalingUpDataTrans1LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap);
-TbResult LbSpriteDrawUsingScalingDownDataTrans1RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap);
-TbResult LbSpriteDrawUsingScalingDownDataTrans1LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap);
-
+/******************************************************************************/
 
 TbResult DrawAlphaSpriteUsingScalingData(long posx, long posy, const TbSprite *sprite)
 {
@@ -75,31 +66,8 @@ TbResult DrawAlphaSpriteUsingScalingData(long posx, long posy, const TbSprite *s
         outbuf = &lbDisplay.GraphicsWindowPtr[gspos_x + lbDisplay.GraphicsScreenWidth * gspos_y];
         outheight = lbDisplay.GraphicsScreenHeight;
     }
-    if ( alpha_scale_up )
-    {
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-        {
-            return LbSpriteDrawUsingScalingUpDataTrans1RL(outbuf, scanline, outheight,
-              xstep, ystep, sprite, render_alpha);
-        }
-        else
-        {
-            return LbSpriteDrawUsingScalingUpDataTrans1LR(outbuf, scanline, outheight,
-              xstep, ystep, sprite, render_alpha);
-        }
-    }
-    else
-    {
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-        {
-            return LbSpriteDrawUsingScalingDownDataTrans1RL(outbuf, scanline, outheight,
-              xstep, ystep, sprite, render_alpha);
-        }
-        else
-        {
-            return LbSpriteDrawUsingScalingDownDataTrans1LR(outbuf, scanline, outheight,
-              xstep, ystep, sprite, render_alpha);
-        }
-    }
+    return LbSpriteDrawDecodedUsingScaling(outbuf, scanline, outheight, xstep, ystep,
+      ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0), alpha_scale_up, sprite,
+      SprBl_TransSrcDst, render_alpha);
 }
 /******************************************************************************/
@@ -27,1227 +27,6 @@
 #include "privbflog.h"
 
 /******************************************************************************/
-void LbPixelBlockCopyForward(TbPixel * dst, const TbPixel * src, long len);
-// The functions below are from colour remap version of the routine - they're used for shadows of sprites
-TbResult LbSpriteDrawRemapUsingScalingUpDataSolidRL(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite, const TbPixel *cmap);
-TbResult LbSpriteDrawRemapUsingScalingUpDataSolidLR(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite, const TbPixel *cmap);
-TbResult LbSpriteDrawRemapUsingScalingDownDataSolidRL(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite, const TbPixel *cmap);
-TbResult LbSpriteDrawRemapUsingScalingDownDataSolidLR(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite, const TbPixel *cmap);
-/******************************************************************************/
-
-/**
- * Draws a scaled up sprite on given buffer, with transparency mapping, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataTrans1RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            unsigned char *prevdata;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            prevdata = sprdata;
-            while (ydup > 0)
-            {
-                sprdata = prevdata;
-                xcurstep = xstep;
-                TbPixel *out_end;
-                out_end = outbuf;
-                while ( 1 )
-                {
-                    long pxlen;
-                    pxlen = (signed char)*sprdata;
-                    sprdata++;
-                    if (pxlen == 0)
-                        break;
-                    if (pxlen < 0)
-                    {
-                        pxlen = -pxlen;
-                        out_end -= xcurstep[0] + xcurstep[1];
-                        xcurstep -= 2 * pxlen;
-                        out_end += xcurstep[0] + xcurstep[1];
-                    }
-                    else
-                    {
-                        for (;pxlen > 0; pxlen--)
-                        {
-                            xdup = xcurstep[1];
-                            if (xcurstep[0]+xdup > abs(scanline))
-                                xdup = abs(scanline)-xcurstep[0];
-                            if (xdup > 0)
-                            {
-                                unsigned int pxmap;
-                                pxmap = ((*sprdata) << 8);
-                                for (;xdup > 0; xdup--)
-                                {
-                                    pxmap = (pxmap & ~0x00ff) | ((*out_end));
-                                    *out_end = transmap[pxmap];
-                                    out_end--;
-                                }
-                            }
-                            sprdata++;
-                            xcurstep -= 2;
-                        }
-                    }
-                }
-                outbuf += scanline;
-                ydup--;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled up sprite on given buffer, with transparency mapping, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used. Should have
- *     a size of 256x256 to avoid invalid memory reads.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataTrans1LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            unsigned char *prevdata;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            prevdata = sprdata;
-            while (ydup > 0)
-            {
-                sprdata = prevdata;
-                xcurstep = xstep;
-                TbPixel *out_end;
-                out_end = outbuf;
-                while ( 1 )
-                {
-                    long pxlen;
-                    pxlen = (signed char)*sprdata;
-                    sprdata++;
-                    if (pxlen == 0)
-                        break;
-                    if (pxlen < 0)
-                    {
-                        pxlen = -pxlen;
-                        out_end -= xcurstep[0];
-                        xcurstep += 2 * pxlen;
-                        out_end += xcurstep[0];
-                    }
-                    else
-                    {
-                        for (;pxlen > 0; pxlen--)
-                        {
-                            xdup = xcurstep[1];
-                            if (xcurstep[0]+xdup > abs(scanline))
-                                xdup = abs(scanline)-xcurstep[0];
-                            if (xdup > 0)
-                            {
-                                unsigned int pxmap;
-                                pxmap = ((*sprdata) << 8);
-                                for (;xdup > 0; xdup--)
-                                {
-                                    pxmap = (pxmap & ~0x00ff) | ((*out_end));
-                                    *out_end = transmap[pxmap];
-                                    out_end++;
-                                }
-                            }
-                            sprdata++;
-                            xcurstep += 2;
-                        }
-                    }
-                }
-                outbuf += scanline;
-                ydup--;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled up sprite on given buffer, with reversed transparency mapping, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataTrans2RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            unsigned char *prevdata;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            prevdata = sprdata;
-            while (ydup > 0)
-            {
-                sprdata = prevdata;
-                xcurstep = xstep;
-                TbPixel *out_end;
-                out_end = outbuf;
-                while ( 1 )
-                {
-                    long pxlen;
-                    pxlen = (signed char)*sprdata;
-                    sprdata++;
-                    if (pxlen == 0)
-                        break;
-                    if (pxlen < 0)
-                    {
-                        pxlen = -pxlen;
-                        out_end -= xcurstep[0] + xcurstep[1];
-                        xcurstep -= 2 * pxlen;
-                        out_end += xcurstep[0] + xcurstep[1];
-                    }
-                    else
-                    {
-                        for (;pxlen > 0; pxlen--)
-                        {
-                            xdup = xcurstep[1];
-                            if (xcurstep[0]+xdup > abs(scanline))
-                                xdup = abs(scanline)-xcurstep[0];
-                            if (xdup > 0)
-                            {
-                                unsigned int pxmap;
-                                pxmap = (*sprdata);
-                                for (;xdup > 0; xdup--)
-                                {
-                                    pxmap = (pxmap & ~0xff00) | ((*out_end) << 8);
-                                    *out_end = transmap[pxmap];
-                                    out_end--;
-                                }
-                            }
-                            sprdata++;
-                            xcurstep -= 2;
-                        }
-                    }
-                }
-                outbuf += scanline;
-                ydup--;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled up sprite on given buffer, with reversed transparency mapping, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataTrans2LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            unsigned char *prevdata;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            prevdata = sprdata;
-            while (ydup > 0)
-            {
-                sprdata = prevdata;
-                xcurstep = xstep;
-                TbPixel *out_end;
-                out_end = outbuf;
-                while ( 1 )
-                {
-                    long pxlen;
-                    pxlen = (signed char)*sprdata;
-                    sprdata++;
-                    if (pxlen == 0)
-                        break;
-                    if (pxlen < 0)
-                    {
-                        pxlen = -pxlen;
-                        out_end -= xcurstep[0];
-                        xcurstep += 2 * pxlen;
-                        out_end += xcurstep[0];
-                    }
-                    else
-                    {
-                        for (;pxlen > 0; pxlen--)
-                        {
-                            xdup = xcurstep[1];
-                            if (xcurstep[0]+xdup > abs(scanline))
-                                xdup = abs(scanline)-xcurstep[0];
-                            if (xdup > 0)
-                            {
-                                unsigned int pxmap;
-                                pxmap = (*sprdata);
-                                for (;xdup > 0; xdup--)
-                                {
-                                    pxmap = (pxmap & ~0xff00) | ((*out_end) << 8);
-                                    *out_end = transmap[pxmap];
-                                    out_end++;
-                                }
-                            }
-                            sprdata++;
-                            xcurstep += 2;
-                        }
-                    }
-                }
-                outbuf += scanline;
-                ydup--;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled up sprite on given buffer, with original colours, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataSolidRL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            int ycur;
-            int solid_len;
-            TbPixel * out_line;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0] + xcurstep[1];
-                    xcurstep -= 2 * pxlen;
-                    out_end += xcurstep[0] + xcurstep[1];
-                }
-                else
-                {
-                    TbPixel *out_start;
-                    out_start = out_end;
-                    for(;pxlen > 0; pxlen--)
-                    {
-                        xdup = xcurstep[1];
-                        if (xcurstep[0]+xdup > abs(scanline))
-                            xdup = abs(scanline)-xcurstep[0];
-                        if (xdup > 0)
-                        {
-                            unsigned char pxval;
-                            pxval = *sprdata;
-                            for (;xdup > 0; xdup--)
-                            {
-                                *out_end = pxval;
-                                out_end--;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep -= 2;
-                    }
-                    ycur = ydup - 1;
-                    if (ycur > 0)
-                    {
-                        solid_len = out_start - out_end;
-                        out_start = out_end;
-                        solid_len++;
-                        out_line = out_start + scanline;
-                        for (;ycur > 0; ycur--)
-                        {
-                            if (solid_len > 0) {
-                                LbPixelBlockCopyForward(out_line, out_start, solid_len);
-                            }
-                            out_line += scanline;
-                        }
-                    }
-                }
-            }
-            outbuf += scanline;
-            ycur = ydup - 1;
-            for (;ycur > 0; ycur--)
-            {
-                outbuf += scanline;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled up sprite on given buffer, with original colours, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param outheight
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingUpDataSolidLR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            int ycur;
-            int solid_len;
-            TbPixel * out_line;
-            int xdup, ydup;
-            long *xcurstep;
-            ydup = ycurstep[1];
-            if (ycurstep[0]+ydup > outheight)
-                ydup = outheight-ycurstep[0];
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0];
-                    xcurstep += 2 * pxlen;
-                    out_end += xcurstep[0];
-                }
-                else
-                {
-                    TbPixel *out_start;
-                    out_start = out_end;
-                    for(;pxlen > 0; pxlen--)
-                    {
-                        xdup = xcurstep[1];
-                        if (xcurstep[0]+xdup > abs(scanline))
-                            xdup = abs(scanline)-xcurstep[0];
-                        if (xdup > 0)
-                        {
-                            unsigned char pxval;
-                            pxval = *sprdata;
-                            for (;xdup > 0; xdup--)
-                            {
-                                *out_end = pxval;
-                                out_end++;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep += 2;
-                    }
-                    ycur = ydup - 1;
-                    if (ycur > 0)
-                    {
-                        solid_len = out_end - out_start;
-                        out_line = out_start + scanline;
-                        for (;ycur > 0; ycur--)
-                        {
-                            if (solid_len > 0) {
-                                LbPixelBlockCopyForward(out_line, out_start, solid_len);
-                            }
-                            out_line += scanline;
-                        }
-                    }
-                }
-            }
-            outbuf += scanline;
-            ycur = ydup - 1;
-            for (;ycur > 0; ycur--)
-            {
-                outbuf += scanline;
-            }
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with transparency mapping, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataTrans1RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0] + xcurstep[1];
-                    xcurstep -= 2 * pxlen;
-                    out_end += xcurstep[0] + xcurstep[1];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned int pxmap;
-                            pxmap = ((*sprdata) << 8);
-                            {
-                                pxmap = (pxmap & ~0x00ff) | ((*out_end));
-                                *out_end = transmap[pxmap];
-                                out_end--;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep -= 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with transparency mapping, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataTrans1LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0];
-                    xcurstep += 2 * pxlen;
-                    out_end += xcurstep[0];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned int pxmap;
-                            pxmap = ((*sprdata) << 8);
-                            {
-                                pxmap = (pxmap & ~0x00ff) | ((*out_end));
-                                *out_end = transmap[pxmap];
-                                out_end++;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep += 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with reverse transparency mapping, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataTrans2RL(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0] + xcurstep[1];
-                    xcurstep -= 2 * pxlen;
-                    out_end += xcurstep[0] + xcurstep[1];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned int pxmap;
-                            pxmap = ((*sprdata));
-                            {
-                                pxmap = (pxmap & ~0xff00) | ((*out_end) << 8);
-                                *out_end = transmap[pxmap];
-                                out_end--;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep -= 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with reverse transparency mapping, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @param transmap The transparency mapping table to be used.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataTrans2LR(ubyte *outbuf, int scanline, int outheight,
-  long *xstep, long *ystep, const TbSprite *sprite, const unsigned char *transmap)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0];
-                    xcurstep += 2 * pxlen;
-                    out_end += xcurstep[0];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned int pxmap;
-                            pxmap = ((*sprdata));
-                            {
-                                pxmap = (pxmap & ~0xff00) | ((*out_end) << 8);
-                                *out_end = transmap[pxmap];
-                                out_end++;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep += 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with original colours, from right to left.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataSolidRL(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0] + xcurstep[1];
-                    xcurstep -= 2 * pxlen;
-                    out_end += xcurstep[0] + xcurstep[1];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned char pxval;
-                            pxval = *sprdata;
-                            {
-                                *out_end = pxval;
-                                out_end--;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep -= 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
-
-/**
- * Draws a scaled down sprite on given buffer, with original colours, from left to right.
- * Requires step arrays for scaling.
- *
- * @param outbuf The output buffer.
- * @param scanline Length of the output buffer scanline.
- * @param xstep Scaling steps array, x dimension.
- * @param ystep Scaling steps array, y dimension.
- * @param sprite The source sprite.
- * @return Gives 0 on success.
- */
-TbResult LbSpriteDrawUsingScalingDownDataSolidLR(ubyte *outbuf, int scanline,
-  int outheight, long *xstep, long *ystep, const TbSprite *sprite)
-{
-    int ystep_delta;
-    unsigned char *sprdata;
-    long *ycurstep;
-
-    LOGDBG("drawing");
-    ystep_delta = 2;
-    if (scanline < 0) {
-        ystep_delta = -2;
-    }
-    sprdata = sprite->Data;
-    ycurstep = ystep;
-
-    int h;
-    for (h=sprite->SHeight; h > 0; h--)
-    {
-        if (ycurstep[1] != 0)
-        {
-            long *xcurstep;
-            xcurstep = xstep;
-            TbPixel *out_end;
-            out_end = outbuf;
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                    break;
-                if (pxlen < 0)
-                {
-                    pxlen = -pxlen;
-                    out_end -= xcurstep[0];
-                    xcurstep += 2 * pxlen;
-                    out_end += xcurstep[0];
-                }
-                else
-                {
-                    for (;pxlen > 0; pxlen--)
-                    {
-                        if (xcurstep[1] > 0)
-                        {
-                            unsigned char pxval;
-                            pxval = *sprdata;
-                            {
-                                *out_end = pxval;
-                                out_end++;
-                            }
-                        }
-                        sprdata++;
-                        xcurstep += 2;
-                    }
-                }
-            }
-            outbuf += scanline;
-        }
-        else
-        {
-            while ( 1 )
-            {
-                long pxlen;
-                pxlen = (signed char)*sprdata;
-                sprdata++;
-                if (pxlen == 0)
-                  break;
-                if (pxlen > 0)
-                {
-                    sprdata += pxlen;
-                }
-            }
-        }
-        ycurstep += ystep_delta;
-    }
-    return 0;
-}
 
 TbResult LbSpriteDrawUsingScalingData(long posx, long posy, const TbSprite *sprite)
 {
@@ -1284,123 +63,31 @@ TbResult LbSpriteDrawUsingScalingData(long posx, long posy, const TbSprite *spri
         outbuf = &lbDisplay.GraphicsWindowPtr[gspos_x + lbDisplay.GraphicsScreenWidth * gspos_y];
         outheight = lbDisplay.GraphicsScreenHeight;
     }
-    if ( scale_up )
+    TbBool flip_horiz;
+    flip_horiz = ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0);
+    if ((lbDisplay.DrawFlags & Lb_TEXT_UNDERLNSHADOW) != 0)
     {
-        if ((lbDisplay.DrawFlags & Lb_TEXT_UNDERLNSHADOW) != 0)
-        {
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawRemapUsingScalingUpDataSolidRL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, lbSpriteReMapPtr);
-          }
-          else
-          {
-              return LbSpriteDrawRemapUsingScalingUpDataSolidLR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, lbSpriteReMapPtr);
-          }
-        }
-        else
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR4) != 0)
-        {
-          assert(render_ghost != NULL);
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingUpDataTrans1RL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingUpDataTrans1LR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-        }
-        else
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR8) != 0)
-        {
-          assert(render_ghost != NULL);
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingUpDataTrans2RL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingUpDataTrans2LR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-        }
-        else
-        {
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingUpDataSolidRL(outbuf, scanline,
-               outheight, xstep, ystep, sprite);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingUpDataSolidLR(outbuf, scanline,
-               outheight, xstep, ystep, sprite);
-          }
-        }
+        return LbSpriteDrawDecodedUsingScaling(outbuf, scanline, outheight,
+          xstep, ystep, flip_horiz, scale_up, sprite, SprBl_Remap, lbSpriteReMapPtr);
     }
     else
+    if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR4) != 0)
     {
-        if ((lbDisplay.DrawFlags & Lb_TEXT_UNDERLNSHADOW) != 0)
-        {
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawRemapUsingScalingDownDataSolidRL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, lbSpriteReMapPtr);
-          }
-          else
-          {
-              return LbSpriteDrawRemapUsingScalingDownDataSolidLR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, lbSpriteReMapPtr);
-          }
-        }
-        else
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR4) != 0)
-        {
-          assert(render_ghost != NULL);
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingDownDataTrans1RL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingDownDataTrans1LR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-        }
-        else
-        if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR8) != 0)
-        {
-          assert(render_ghost != NULL);
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingDownDataTrans2RL(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingDownDataTrans2LR(outbuf, scanline,
-               outheight, xstep, ystep, sprite, render_ghost);
-          }
-        }
-        else
-        {
-          if ((lbDisplay.DrawFlags & Lb_SPRITE_FLIP_HORIZ) != 0)
-          {
-              return LbSpriteDrawUsingScalingDownDataSolidRL(outbuf, scanline,
-               outheight, xstep, ystep, sprite);
-          }
-          else
-          {
-              return LbSpriteDrawUsingScalingDownDataSolidLR(outbuf, scanline,
-               outheight, xstep, ystep, sprite);
-          }
-        }
+        assert(render_ghost != NULL);
+        return LbSpriteDrawDecodedUsingScaling(outbuf, scanline, outheight,
+          xstep, ystep, flip_horiz, scale_up, sprite, SprBl_TransSrcDst, render_ghost);
+    }
+    else
+    if ((lbDisplay.DrawFlags & Lb_SPRITE_TRANSPAR8) != 0)
+    {
+        assert(render_ghost != NULL);
+        return LbSpriteDrawDecodedUsingScaling(outbuf, scanline, outheight,
+          xstep, ystep, flip_horiz, scale_up, sprite, SprBl_TransDstSrc, render_ghost);
+    }
+    else
+    {
+        return LbSpriteDrawDecodedUsingScaling(outbuf, scanline, outheight,
+          xstep, ystep, flip_horiz, scale_up, sprite, SprBl_Solid, NULL);
     }
 }
 
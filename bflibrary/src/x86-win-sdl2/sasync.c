@@ -0,0 +1,419 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file sasync.c
+ *     Implementation of related functions.
+ * @par Purpose:
+ *     Loading files on a background thread.
+ * @par Comment:
+ *     The background thread only reads and unpacks files into its own buffers;
+ *     memory arenas and all other library state are touched by the main thread
+ *     alone, when it collects the data. This includes the log - the thread uses
+ *     plain OS calls instead of bffile.h, and returns the error code in a job.
+ *     The same source is used for both SDL1 and SDL2 builds.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include <SDL.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bfasync.h"
+
+#include "bfendian.h"
+#include "bffile.h"
+#include "rnc_1fm.h"
+#include "privbflog.h"
+/******************************************************************************/
+
+enum AsyncFileJobState {
+    AsFJS_Free = 0,
+    AsFJS_Queued,
+    AsFJS_Loading,
+    /** The job was cancelled while loading; the thread will free it. */
+    AsFJS_Cancelled,
+    AsFJS_Done,
+    AsFJS_Failed,
+};
+
+struct AsyncFileJob {
+    char Fname[DISKPATH_SIZE];
+    /** File name after transformation, prepared by the main thread. */
+    char RealFname[FILENAME_MAX];
+    ubyte State;
+    /** Sequence number of the request; jobs are processed in request order. */
+    ulong Seq;
+    ubyte *Data;
+    long Size;
+    /** Value of errno on failed load, or 0 if the packed data was invalid. */
+    int Error;
+};
+
+static struct AsyncFileJob async_jobs[ASYNC_FILE_JOBS_LIMIT];
+static ulong async_jobs_seq = 0;
+
+static SDL_Thread *async_thread = NULL;
+static SDL_mutex *async_mutex = NULL;
+/** Signalled when a job is queued. */
+static SDL_cond *async_cond_queued = NULL;
+/** Signalled when a job is finished. */
+static SDL_cond *async_cond_done = NULL;
+/** Set when the background thread should exit. */
+static TbBool async_quit = false;
+
+/** How long the main thread waits before executing idle callback again. */
+#define ASYNC_FILE_IDLE_WAIT_MS 10
+
+/******************************************************************************/
+
+/** Reads whole file into a new buffer. Executed on the background thread.
+ *
+ * Cannot use bffile.h routines, as these write to the log.
+ */
+static long async_file_read(const char *fname, ubyte **p_data, int *p_error)
+{
+    struct stat st;
+    ubyte *buf;
+    long len, pos;
+    int fd;
+
+    *p_data = NULL;
+#if defined(WIN32)||defined(DOS)||defined(GO32)
+    fd = open(fname, O_RDONLY|O_BINARY);
+#else
+    fd = open(fname, O_RDONLY);
+#endif
+    if (fd < 0) {
+        *p_error = errno;
+        return -1;
+    }
+    if (fstat(fd, &st) != 0) {
+        *p_error = errno;
+        close(fd);
+        return -1;
+    }
+    len = st.st_size;
+    buf = malloc(len + 1);
+    if (buf == NULL) {
+        *p_error = ENOMEM;
+        close(fd);
+        return -1;
+    }
+    for (pos = 0; pos < len; )
+    {
+        long nread;
+
+        nread = read(fd, buf + pos, len - pos);
+        if (nread <= 0) {
+            *p_error = (nread < 0) ? errno : EIO;
+            close(fd);
+            free(buf);
+            return -1;
+        }
+        pos += nread;
+    }
+    close(fd);
+    *p_data = buf;
+    return len;
+}
+
+/** Reads and unpacks a file. Executed on the background thread.
+ */
+static long async_file_load(const char *fname, ubyte **p_data, int *p_error)
+{
+    ubyte *buf;
+    ubyte *unp_buf;
+    long len, unp_len;
+
+    *p_error = 0;
+    len = async_file_read(fname, &buf, p_error);
+    *p_data = NULL;
+    if (len < 0)
+        return -1;
+
+    if ((len < RNC_HEADER_LEN) || (blong(buf+0) != RNC_SIGNATURE)) {
+        *p_data = buf;
+        return len;
+    }
+    if (blong(buf+8) > (ulong)(len - RNC_HEADER_LEN)) {
+        free(buf);
+        return -1;
+    }
+    unp_len = blong(buf+4);
+    unp_buf = malloc(unp_len + 1);
+    if (unp_buf == NULL) {
+        free(buf);
+        *p_error = ENOMEM;
+        return -1;
+    }
+    unp_len = rnc_unpack(buf, unp_buf, 0);
+    free(buf);
+    if (unp_len < 0) {
+        free(unp_buf);
+        return -1;
+    }
+    *p_data = unp_buf;
+    return unp_len;
+}
+
+static struct AsyncFileJob *async_file_next_queued_job(void)
+{
+    struct AsyncFileJob *p_job;
+    int i;
+
+    p_job = NULL;
+    for (i = 0; i < ASYNC_FILE_JOBS_LIMIT; i++)
+    {
+        if (async_jobs[i].State != AsFJS_Queued)
+            continue;
+        if ((p_job == NULL) || (async_jobs[i].Seq < p_job->Seq))
+            p_job = &async_jobs[i];
+    }
+    return p_job;
+}
+
+static int async_file_thread(void *param)
+{
+    SDL_LockMutex(async_mutex);
+    for (;;)
+    {
+        struct AsyncFileJob *p_job;
+        char fname[FILENAME_MAX];
+        ubyte *data;
+        long size;
+        int error;
+
+        if (async_quit)
+            break;
+        p_job = async_file_next_queued_job();
+        if (p_job == NULL) {
+            SDL_CondWait(async_cond_queued, async_mutex);
+            continue;
+        }
+        p_job->State = AsFJS_Loading;
+        strcpy(fname, p_job->RealFname);
+        SDL_UnlockMutex(async_mutex);
+
+        size = async_file_load(fname, &data, &error);
+
+        SDL_LockMutex(async_mutex);
+        if (p_job->State == AsFJS_Cancelled) {
+            free(data);
+            p_job->State = AsFJS_Free;
+        } else {
+            p_job->Data = data;
+            p_job->Size = size;
+            p_job->Error = error;
+            p_job->State = (size >= 0) ? AsFJS_Done : AsFJS_Failed;
+        }
+        SDL_CondBroadcast(async_cond_done);
+    }
+    SDL_UnlockMutex(async_mutex);
+    return 0;
+}
+
+static void async_file_sync_destroy(void)
+{
+    if (async_cond_done != NULL) {
+        SDL_DestroyCond(async_cond_done);
+        async_cond_done = NULL;
+    }
+    if (async_cond_queued != NULL) {
+        SDL_DestroyCond(async_cond_queued);
+        async_cond_queued = NULL;
+    }
+    if (async_mutex != NULL) {
+        SDL_DestroyMutex(async_mutex);
+        async_mutex = NULL;
+    }
+}
+
+static TbResult async_file_thread_start(void)
+{
+    if (async_thread != NULL)
+        return Lb_SUCCESS;
+    // Make sure the unpacker tables are ready before the thread uses them
+    rnc_crc(NULL, 0);
+    async_mutex = SDL_CreateMutex();
+    async_cond_queued = SDL_CreateCond();
+    async_cond_done = SDL_CreateCond();
+    if ((async_mutex == NULL) || (async_cond_queued == NULL) || (async_cond_done == NULL)) {
+        LOGERR("cannot create synchronization objects: %s", SDL_GetError());
+        async_file_sync_destroy();
+        return Lb_FAIL;
+    }
+#if SDL_VERSION_ATLEAST(2,0,0)
+    async_thread = SDL_CreateThread(async_file_thread, "AsyncFile", NULL);
+#else
+    async_thread = SDL_CreateThread(async_file_thread, NULL);
+#endif
+    if (async_thread == NULL) {
+        LOGERR("cannot create thread: %s", SDL_GetError());
+        async_file_sync_destroy();
+        return Lb_FAIL;
+    }
+    return Lb_SUCCESS;
+}
+
+static struct AsyncFileJob *async_file_find_job(const char *fname)
+{
+    int i;
+
+    for (i = 0; i < ASYNC_FILE_JOBS_LIMIT; i++)
+    {
+        struct AsyncFileJob *p_job;
+
+        p_job = &async_jobs[i];
+        if ((p_job->State == AsFJS_Free) || (p_job->State == AsFJS_Cancelled))
+            continue;
+        if (strcmp(p_job->Fname, fname) == 0)
+            return p_job;
+    }
+    return NULL;
+}
+
+TbResult LbAsyncFileRequest(const char *fname)
+{
+    struct AsyncFileJob *p_job;
+    int i;
+
+    if (strlen(fname) >= DISKPATH_SIZE)
+        return Lb_FAIL;
+    if (async_file_thread_start() != Lb_SUCCESS)
+        return Lb_FAIL;
+
+    SDL_LockMutex(async_mutex);
+    if (async_file_find_job(fname) != NULL) {
+        SDL_UnlockMutex(async_mutex);
+        return Lb_SUCCESS;
+    }
+    p_job = NULL;
+    for (i = 0; i < ASYNC_FILE_JOBS_LIMIT; i++)
+    {
+        if (async_jobs[i].State == AsFJS_Free) {
+            p_job = &async_jobs[i];
+            break;
+        }
+    }
+    if (p_job == NULL) {
+        SDL_UnlockMutex(async_mutex);
+        return Lb_FAIL;
+    }
+    strcpy(p_job->Fname, fname);
+#if LB_FILENAME_TRANSFORM
+    if (lbFileNameTransform != NULL)
+        lbFileNameTransform(p_job->RealFname, fname);
+    else
+#endif
+        strcpy(p_job->RealFname, fname);
+    p_job->Seq = async_jobs_seq++;
+    p_job->Data = NULL;
+    p_job->Size = 0;
+    p_job->Error = 0;
+    p_job->State = AsFJS_Queued;
+    SDL_CondSignal(async_cond_queued);
+    SDL_UnlockMutex(async_mutex);
+    return Lb_SUCCESS;
+}
+
+long LbAsyncFileLoadAt(const char *fname, void *buffer, TbAsyncFileIdleCallback idle_cb)
+{
+    struct AsyncFileJob *p_job;
+    long size;
+
+    if (async_thread == NULL)
+        return LbFileLoadAt(fname, buffer);
+
+    SDL_LockMutex(async_mutex);
+    p_job = async_file_find_job(fname);
+    if (p_job == NULL) {
+        SDL_UnlockMutex(async_mutex);
+        return LbFileLoadAt(fname, buffer);
+    }
+    while ((p_job->State == AsFJS_Queued) || (p_job->State == AsFJS_Loading))
+    {
+        SDL_CondWaitTimeout(async_cond_done, async_mutex, ASYNC_FILE_IDLE_WAIT_MS);
+        if (idle_cb != NULL) {
+            // Do not block the background thread while the callback runs
+            SDL_UnlockMutex(async_mutex);
+            idle_cb();
+            SDL_LockMutex(async_mutex);
+        }
+    }
+    size = p_job->Size;
+    if (p_job->State == AsFJS_Done) {
+        memcpy(buffer, p_job->Data, size);
+    } else {
+        if (p_job->Error != 0)
+            LOGERR("%s: background load failed: %s", fname, strerror(p_job->Error));
+        else
+            LOGERR("%s: background load failed: invalid packed data", fname);
+        size = -1;
+    }
+    free(p_job->Data);
+    p_job->Data = NULL;
+    p_job->State = AsFJS_Free;
+    SDL_UnlockMutex(async_mutex);
+    return size;
+}
+
+void LbAsyncFileCancelAll(void)
+{
+    int i;
+
+    if (async_thread == NULL)
+        return;
+    SDL_LockMutex(async_mutex);
+    for (i = 0; i < ASYNC_FILE_JOBS_LIMIT; i++)
+    {
+        struct AsyncFileJob *p_job;
+
+        p_job = &async_jobs[i];
+        switch (p_job->State)
+        {
+        case AsFJS_Loading:
+            p_job->State = AsFJS_Cancelled;
+            break;
+        case AsFJS_Queued:
+        case AsFJS_Done:
+        case AsFJS_Failed:
+            free(p_job->Data);
+            p_job->Data = NULL;
+            p_job->State = AsFJS_Free;
+            break;
+        default:
+            break;
+        }
+    }
+    SDL_UnlockMutex(async_mutex);
+}
+
+void LbAsyncFileShutdown(void)
+{
+    if (async_thread == NULL)
+        return;
+    LbAsyncFileCancelAll();
+    SDL_LockMutex(async_mutex);
+    async_quit = true;
+    SDL_CondBroadcast(async_cond_queued);
+    SDL_UnlockMutex(async_mutex);
+    // A load in progress is finished and freed by the thread before it exits
+    SDL_WaitThread(async_thread, NULL);
+    async_thread = NULL;
+    async_quit = false;
+    async_file_sync_destroy();
+}
+
+/******************************************************************************/
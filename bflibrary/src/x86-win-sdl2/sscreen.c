@@ -18,6 +18,7 @@
  */
 /******************************************************************************/
 #include <assert.h>
+#include <stdlib.h>
 #include <SDL.h>
 #include <SDL_syswm.h>
 #include "bfscreen.h"
@@ -994,6 +995,334 @@ static void LbI_SDL_BlitScaled_totcbpp(long src_w, long src_h, long src_scanln,
     }
 }
 
+/** Palette expanded to the destination pixel format, for blits to 32bpp.
+ * Rebuilt only when the palette or destination format changes.
+ */
+static u32 blit_pal_lut[256];
+static const SDL_Palette *blit_pal_lut_pal = NULL;
+static Uint32 blit_pal_lut_version = 0;
+static long blit_pal_lut_shifts = -1;
+
+/** Source column for each destination column, and source row for each
+ * destination row, of the last scaled blit. Rebuilt on size change.
+ */
+static long *blit_map_cols = NULL;
+static long *blit_map_rows = NULL;
+static long blit_map_src_w = 0, blit_map_src_h = 0;
+static long blit_map_dst_w = 0, blit_map_dst_h = 0;
+/** If each source pixel is repeated the same amount of times in a row,
+ * this is the amount; otherwise zero. */
+static long blit_map_repeat = 0;
+
+enum BlitRowKernel {
+    BlRK_Unknown = 0,
+    BlRK_Scalar,
+    BlRK_SSE2,
+    BlRK_AVX2,
+};
+
+static ubyte blit_row_kernel = BlRK_Unknown;
+
+static void LbI_BlitPalLUTUpdate(const SDL_Palette *pal, long rshift, long gshift, long bshift)
+{
+    long shifts;
+    int i;
+
+    shifts = (rshift << 16) | (gshift << 8) | bshift;
+    if ((blit_pal_lut_pal == pal) && (blit_pal_lut_version == pal->version) &&
+      (blit_pal_lut_shifts == shifts))
+        return;
+
+    for (i = 0; i < 256; i++)
+    {
+        SDL_Color c;
+
+        if (i < pal->ncolors)
+            c = pal->colors[i];
+        else
+            c.r = c.g = c.b = 0;
+        blit_pal_lut[i] = ((u32)c.r << rshift) + ((u32)c.g << gshift) + ((u32)c.b << bshift);
+    }
+    blit_pal_lut_pal = pal;
+    blit_pal_lut_version = pal->version;
+    blit_pal_lut_shifts = shifts;
+}
+
+/** Fills the source offset map for one dimension.
+ *
+ * Uses the same fractional stepping as LbI_SDL_BlitScaled_to8bpp(),
+ * so both blits take the same source pixels.
+ */
+static void LbI_BlitScaledMapFill(long *map, long src_len, long dst_len)
+{
+    const long denom = 2 * dst_len;
+    const long dsrc = 2 * src_len / denom;
+    const long dsrc_num = (2 * src_len) - dsrc * denom;
+    const long halfdsrc = src_len / denom;
+    long src_pos, src_num;
+    long k;
+
+    src_pos = halfdsrc;
+    src_num = src_len - halfdsrc * denom;
+    for (k = 0; k != dst_len; ++k) {
+        if (src_num > denom) {
+            src_num -= denom;
+            ++src_pos;
+        }
+        map[k] = src_pos;
+        src_pos += dsrc;
+        src_num += dsrc_num;
+    }
+}
+
+static TbResult LbI_BlitScaledMapUpdate(long src_w, long src_h, long dst_w, long dst_h)
+{
+    long j;
+
+    if ((blit_map_src_w == src_w) && (blit_map_src_h == src_h) &&
+      (blit_map_dst_w == dst_w) && (blit_map_dst_h == dst_h))
+        return Lb_SUCCESS;
+
+    free(blit_map_cols);
+    free(blit_map_rows);
+    blit_map_cols = malloc(dst_w * sizeof(long));
+    blit_map_rows = malloc(dst_h * sizeof(long));
+    if ((blit_map_cols == NULL) || (blit_map_rows == NULL)) {
+        free(blit_map_cols);
+        free(blit_map_rows);
+        blit_map_cols = blit_map_rows = NULL;
+        blit_map_src_w = blit_map_src_h = 0;
+        blit_map_dst_w = blit_map_dst_h = 0;
+        return Lb_FAIL;
+    }
+    LbI_BlitScaledMapFill(blit_map_cols, src_w, dst_w);
+    LbI_BlitScaledMapFill(blit_map_rows, src_h, dst_h);
+
+    blit_map_repeat = 0;
+    if ((src_w > 0) && (dst_w % src_w) == 0)
+    {
+        long repeat;
+
+        repeat = dst_w / src_w;
+        for (j = 0; j < dst_w; j++) {
+            if (blit_map_cols[j] != j / repeat)
+                break;
+        }
+        if (j == dst_w)
+            blit_map_repeat = repeat;
+    }
+
+    blit_map_src_w = src_w;
+    blit_map_src_h = src_h;
+    blit_map_dst_w = dst_w;
+    blit_map_dst_h = dst_h;
+    return Lb_SUCCESS;
+}
+
+static void LbI_BlitRow_scalar(const ubyte *src_row, u32 *dst_row, long dst_w)
+{
+    const long *cols = blit_map_cols;
+    long j;
+
+    for (j = 0; j + 4 <= dst_w; j += 4) {
+        dst_row[j+0] = blit_pal_lut[src_row[cols[j+0]]];
+        dst_row[j+1] = blit_pal_lut[src_row[cols[j+1]]];
+        dst_row[j+2] = blit_pal_lut[src_row[cols[j+2]]];
+        dst_row[j+3] = blit_pal_lut[src_row[cols[j+3]]];
+    }
+    for (; j < dst_w; j++)
+        dst_row[j] = blit_pal_lut[src_row[cols[j]]];
+}
+
+static void LbI_BlitRowRepeat_scalar(const ubyte *src_row, u32 *dst_row, long src_w)
+{
+    const long repeat = blit_map_repeat;
+    long i, k;
+
+    for (i = 0; i < src_w; i++) {
+        u32 px;
+
+        px = blit_pal_lut[src_row[i]];
+        for (k = 0; k < repeat; k++)
+            *dst_row++ = px;
+    }
+}
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define LB_BLIT_HAVE_X86_SIMD 1
+#include <immintrin.h>
+
+__attribute__((target("sse2")))
+static void LbI_BlitRow_sse2(const ubyte *src_row, u32 *dst_row, long dst_w)
+{
+    const long *cols = blit_map_cols;
+    long j;
+
+    for (j = 0; j + 4 <= dst_w; j += 4) {
+        __m128i px;
+
+        px = _mm_setr_epi32(blit_pal_lut[src_row[cols[j+0]]],
+          blit_pal_lut[src_row[cols[j+1]]], blit_pal_lut[src_row[cols[j+2]]],
+          blit_pal_lut[src_row[cols[j+3]]]);
+        _mm_storeu_si128((__m128i *)(dst_row + j), px);
+    }
+    for (; j < dst_w; j++)
+        dst_row[j] = blit_pal_lut[src_row[cols[j]]];
+}
+
+__attribute__((target("sse2")))
+static void LbI_BlitRowRepeat_sse2(const ubyte *src_row, u32 *dst_row, long src_w)
+{
+    const long repeat = blit_map_repeat;
+    long i, k;
+
+    for (i = 0; i < src_w; i++) {
+        u32 px;
+        __m128i px4;
+
+        px = blit_pal_lut[src_row[i]];
+        px4 = _mm_set1_epi32(px);
+        for (k = 0; k + 4 <= repeat; k += 4) {
+            _mm_storeu_si128((__m128i *)dst_row, px4);
+            dst_row += 4;
+        }
+        if (k + 2 <= repeat) {
+            _mm_storel_epi64((__m128i *)dst_row, px4);
+            dst_row += 2;
+            k += 2;
+        }
+        if (k < repeat)
+            *dst_row++ = px;
+    }
+}
+
+__attribute__((target("avx2")))
+static void LbI_BlitRow_avx2(const ubyte *src_row, u32 *dst_row, long dst_w)
+{
+    const long *cols = blit_map_cols;
+    long j;
+
+    for (j = 0; j + 8 <= dst_w; j += 8) {
+        __m256i idx, px;
+
+        idx = _mm256_setr_epi32(src_row[cols[j+0]], src_row[cols[j+1]],
+          src_row[cols[j+2]], src_row[cols[j+3]], src_row[cols[j+4]],
+          src_row[cols[j+5]], src_row[cols[j+6]], src_row[cols[j+7]]);
+        px = _mm256_i32gather_epi32((const int *)blit_pal_lut, idx, 4);
+        _mm256_storeu_si256((__m256i *)(dst_row + j), px);
+    }
+    for (; j < dst_w; j++)
+        dst_row[j] = blit_pal_lut[src_row[cols[j]]];
+}
+
+__attribute__((target("avx2")))
+static void LbI_BlitRowRepeat_avx2(const ubyte *src_row, u32 *dst_row, long src_w)
+{
+    const long repeat = blit_map_repeat;
+    long i, k;
+
+    for (i = 0; i < src_w; i++) {
+        u32 px;
+        __m256i px8;
+
+        px = blit_pal_lut[src_row[i]];
+        px8 = _mm256_set1_epi32(px);
+        for (k = 0; k + 8 <= repeat; k += 8) {
+            _mm256_storeu_si256((__m256i *)dst_row, px8);
+            dst_row += 8;
+        }
+        if (k + 4 <= repeat) {
+            _mm_storeu_si128((__m128i *)dst_row, _mm256_castsi256_si128(px8));
+            dst_row += 4;
+            k += 4;
+        }
+        for (; k < repeat; k++)
+            *dst_row++ = px;
+    }
+}
+#endif
+
+static void LbI_BlitRowKernelSelect(void)
+{
+    blit_row_kernel = BlRK_Scalar;
+#if defined(LB_BLIT_HAVE_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        blit_row_kernel = BlRK_AVX2;
+    else if (__builtin_cpu_supports("sse2"))
+        blit_row_kernel = BlRK_SSE2;
+#endif
+    LOGDBG("selected blit row kernel %d", (int)blit_row_kernel);
+}
+
+/** Converts one row of 8bpp pixels into 32bpp, through the palette LUT.
+ */
+static void LbI_BlitRowToRGBA(const ubyte *src_row, u32 *dst_row, long src_w, long dst_w)
+{
+    switch (blit_row_kernel)
+    {
+#if defined(LB_BLIT_HAVE_X86_SIMD)
+    case BlRK_AVX2:
+        if (blit_map_repeat != 0)
+            LbI_BlitRowRepeat_avx2(src_row, dst_row, src_w);
+        else
+            LbI_BlitRow_avx2(src_row, dst_row, dst_w);
+        break;
+    case BlRK_SSE2:
+        if (blit_map_repeat != 0)
+            LbI_BlitRowRepeat_sse2(src_row, dst_row, src_w);
+        else
+            LbI_BlitRow_sse2(src_row, dst_row, dst_w);
+        break;
+#endif
+    default:
+        if (blit_map_repeat != 0)
+            LbI_BlitRowRepeat_scalar(src_row, dst_row, src_w);
+        else
+            LbI_BlitRow_scalar(src_row, dst_row, dst_w);
+        break;
+    }
+}
+
+/** Scaled blit from 8bpp into 32bpp surface, through a palette LUT.
+ *
+ * Source offsets for rows and columns are computed once per size change;
+ * destination rows which take the same source row are copied instead
+ * of converted again.
+ */
+static TbResult LbI_SDL_BlitScaled_to32bpp(long src_w, long src_h, long src_scanln,
+  ubyte *src_buf, const SDL_Palette *pal, long rshift, long gshift, long bshift,
+  long dst_w, long dst_h, long dst_scanln, ubyte *dst_buf)
+{
+    const ubyte *prev_src_row;
+    ubyte *prev_dst_row;
+    long i;
+
+    if (LbI_BlitScaledMapUpdate(src_w, src_h, dst_w, dst_h) != Lb_SUCCESS)
+        return Lb_FAIL;
+    LbI_BlitPalLUTUpdate(pal, rshift, gshift, bshift);
+    if (blit_row_kernel == BlRK_Unknown)
+        LbI_BlitRowKernelSelect();
+
+    prev_src_row = NULL;
+    prev_dst_row = NULL;
+    for (i = 0; i != dst_h; ++i)
+    {
+        const ubyte *src_row;
+        ubyte *dst_row;
+
+        src_row = src_buf + blit_map_rows[i] * src_scanln;
+        dst_row = dst_buf + i * dst_scanln;
+        if (src_row == prev_src_row)
+            LbMemoryCopy(dst_row, prev_dst_row, dst_w * 4);
+        else
+            LbI_BlitRowToRGBA(src_row, (u32 *)dst_row, src_w, dst_w);
+        prev_src_row = src_row;
+        prev_dst_row = dst_row;
+    }
+    return Lb_SUCCESS;
+}
+
 static inline TbBool LbI_SDL_BlitAreasOfSameSize(const SDL_Surface *src, const SDL_Rect *srcrect,
   const SDL_Surface *dst, const SDL_Rect *dstrect)
 {
@@ -1096,7 +1425,9 @@ int LbI_SDL_BlitScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *d
     if (dst_bpp == 1)
         LbI_SDL_BlitScaled_to8bpp(src_w, src_h, src->w, src_buf,
           dst_w, dst_h, dst->w, dst_buf);
-    else
+    else if ((dst_bpp != 4) || (LbI_SDL_BlitScaled_to32bpp(src_w, src_h, src->w, src_buf,
+          src->format->palette, dst->format->Rshift, dst->format->Gshift, dst->format->Bshift,
+          dst_w, dst_h, dst->w * dst_bpp, dst_buf) != Lb_SUCCESS))
         LbI_SDL_BlitScaled_totcbpp(src_w, src_h, src->w, src_buf,
           src->format->palette->colors, dst->format->Rshift, dst->format->Gshift, dst->format->Bshift,
           dst_w, dst_h, dst->w * dst_bpp, dst_bpp, dst_buf);
@@ -78,6 +78,20 @@ TbClockMSec LbTimerClock(void)
 #endif
 }
 
+TbClockUSec LbTimerClockMicro(void)
+{
+#ifndef __unix__
+    if (CLOCKS_PER_SEC >= 1000000)
+        return clock() / (CLOCKS_PER_SEC / 1000000);
+    else
+        return (TbClockUSec)clock() * (1000000 / CLOCKS_PER_SEC);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((TbClockUSec)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+#endif
+}
+
 TbBool LbSleepUntil(TbClockMSec endtime)
 {
     TbClockMSec currclk;
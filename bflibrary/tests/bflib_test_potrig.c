@@ -29,10 +29,12 @@
 #include "bffile.h"
 #include "bfpng.h"
 #include "bfgentab.h"
+#include "bftime.h"
 #include "bfutility.h"
 #include "bftstlog.h"
 
 #include <SDL.h>
+#include <string.h>
 
 #if defined WIN32 && defined main
 // Anti SDL
@@ -148,7 +150,63 @@ void test_trig_draw_random_triangles(const ubyte *pal, short res_h)
     }
 }
 
-TbBool test_trig(void)
+/** Measures speed of rendering modes, by drawing large triangles.
+ *
+ * The results are only logged; the test does not fail on low speed.
+ * Only executed when requested with `--speed` parameter, so that time
+ * of the standard test run does not depend on the machine speed.
+ */
+void test_trig_modes_speed(short res_w, short res_h)
+{
+    const int repeats = 40;
+    struct PolyPoint point_a, point_b, point_c;
+    ulong pixels;
+    int mode, i;
+
+    // Triangle covering half of the screen, with texture and shade gradients
+    point_a.X = 0;
+    point_a.Y = 0;
+    point_a.U = 0;
+    point_a.V = 0;
+    point_a.S = 10 << 16;
+    point_b.X = res_w;
+    point_b.Y = 0;
+    point_b.U = 255 << 16;
+    point_b.V = 0;
+    point_b.S = 60 << 16;
+    point_c.X = 0;
+    point_c.Y = res_h;
+    point_c.U = 0;
+    point_c.V = 255 << 16;
+    point_c.S = 30 << 16;
+    pixels = (ulong)res_w * res_h / 2;
+
+    for (mode = 0; mode < 27; mode++)
+    {
+        TbClockUSec start_tm, exec_tm;
+
+        vec_mode = mode;
+        vec_colour = 0x8F;
+        start_tm = LbTimerClockMicro();
+        for (i = 0; i < repeats; i++)
+        {
+            struct PolyPoint pt_a, pt_b, pt_c;
+
+            // trig() may modify the points
+            pt_a = point_a;
+            pt_b = point_b;
+            pt_c = point_c;
+            trig(&pt_a, &pt_b, &pt_c);
+        }
+        exec_tm = LbTimerClockMicro() - start_tm;
+        if (exec_tm < 1)
+            exec_tm = 1;
+        LOGSYNC("mode %2d: %.1f Mpixels/s", mode,
+          (double)pixels * repeats / exec_tm);
+    }
+}
+
+TbBool test_trig(TbBool measure_speed)
 {
     static ulong seeds[] = {0x0, 0xD15C1234, 0xD15C0000, 0xD15C0005, 0xD15C000F, 0xD15C03DC,
       0xD15C07DF, 0xD15CE896, 0xB00710FA, };
@@ -237,6 +295,9 @@ TbBool test_trig(void)
             loc_fname, maxdiff, maxpos % mdinfo->Width, maxpos / mdinfo->Width);
     }
 
+    if (measure_speed)
+        test_trig_modes_speed(mdinfo->Width, mdinfo->Height);
+
     LbMemoryFree(texmap);
     free(ref_buffer);
 
@@ -249,7 +310,10 @@ TbBool test_trig(void)
 
 int main(int argc, char *argv[])
 {
-    if (!test_trig())
+    TbBool measure_speed;
+
+    measure_speed = (argc > 1) && (strcmp(argv[1], "--speed") == 0);
+    if (!test_trig(measure_speed))
         exit(51);
     exit(0);
 }
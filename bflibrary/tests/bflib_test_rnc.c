@@ -0,0 +1,366 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file bflib_test_rnc.c
+ *     Test application for RNC decompression.
+ * @par Purpose:
+ *     Testing implementation of bflibrary routines.
+ * @par Comment:
+ *     Any files given as parameters are also tested; RNC files are unpacked
+ *     and compared with reference unpacker output, other files are packed
+ *     and unpacked back. Speed of both unpackers is reported.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rnc_1fm.h"
+#include "bfendian.h"
+
+#include "../tests/helpers_rnc.h"
+#include "bftstlog.h"
+
+/** Extra space after buffers; unpacker may peek a word past the end. */
+#define RNC_TEST_BUF_PAD 64
+/** Minimal time of each speed measurement, in clock ticks. */
+#define RNC_TEST_BENCH_TICKS (CLOCKS_PER_SEC / 5)
+
+enum RncTestDataKind {
+    RnTDat_Text = 0,
+    RnTDat_Random,
+    RnTDat_Runs,
+    RnTDat_Mixed,
+    RnTDat_COUNT,
+};
+
+/******************************************************************************/
+
+static ulong test_rand_seed = 0x2ED1B9;
+
+static ulong test_rand(void)
+{
+    test_rand_seed = test_rand_seed * 1103515245 + 12345;
+    return (test_rand_seed >> 16) & 0x7FFF;
+}
+
+/** Fills the buffer with data of given kind, for packing tests.
+ */
+static void generate_test_data(ubyte *data, ulong len, int kind)
+{
+    static const char *words[] = {"agent ", "persuadertron ", "minigun ",
+      "zealot ", "church ", "syndicate ", "unguided ", "the ", "of ", "\n"};
+    ulong pos;
+
+    pos = 0;
+    while (pos < len)
+    {
+        int k;
+
+        k = kind;
+        if (k == RnTDat_Mixed)
+            k = (pos / 4096) % RnTDat_Mixed;
+        switch (k)
+        {
+        case RnTDat_Text:
+        {
+            const char *w;
+            w = words[test_rand() % (sizeof(words)/sizeof(words[0]))];
+            while ((*w != '\0') && (pos < len))
+                data[pos++] = *w++;
+            break;
+        }
+        case RnTDat_Random:
+            data[pos++] = test_rand() & 0xFF;
+            break;
+        case RnTDat_Runs:
+        default:
+        {
+            ulong n;
+            ubyte c1, c2;
+            n = 1 + test_rand() % 300;
+            c1 = test_rand() & 0xFF;
+            c2 = (test_rand() & 1) ? c1 : (test_rand() & 0xFF);
+            // Runs of one or two alternating bytes give overlapping matches
+            while ((n-- > 0) && (pos < len)) {
+                data[pos] = (pos & 1) ? c1 : c2;
+                pos++;
+            }
+            break;
+        }
+        }
+    }
+}
+
+static double bench_mbps(ulong len, ulong reps, clock_t ticks)
+{
+    if (ticks <= 0)
+        ticks = 1;
+    return (double)len * reps * CLOCKS_PER_SEC / ticks / (1024.0 * 1024.0);
+}
+
+/** Unpacks data with both unpackers and makes sure results are identical.
+ * @param packed Packed data, with RNC_TEST_BUF_PAD extra bytes.
+ * @param expect Expected unpacked data, or NULL if only comparing.
+ * @param len Unpacked length stored in header.
+ * @param flags Unpacker flags.
+ * @param bench Whether to measure and report speed.
+ */
+static TbBool check_unpack_same(ubyte *packed, const ubyte *expect,
+  ulong len, unsigned int flags, const char *name, TbBool bench)
+{
+    ubyte *out_new, *out_ref;
+    long ret_new, ret_ref;
+    TbBool ok;
+
+    out_new = (ubyte *)malloc(len + RNC_TEST_BUF_PAD);
+    out_ref = (ubyte *)malloc(len + RNC_TEST_BUF_PAD);
+    if ((out_new == NULL) || (out_ref == NULL)) {
+        LOGERR("%s: cannot allocate %lu bytes", name, len);
+        free(out_new);
+        free(out_ref);
+        return false;
+    }
+    memset(out_new, 0xCC, len + RNC_TEST_BUF_PAD);
+    memset(out_ref, 0xCC, len + RNC_TEST_BUF_PAD);
+
+    ok = true;
+    ret_new = rnc_unpack(packed, out_new, flags);
+    ret_ref = rnc_ref_unpack(packed, out_ref, flags);
+    if (ret_new != ret_ref) {
+        LOGERR("%s: unpack returned %ld, reference %ld", name, ret_new, ret_ref);
+        ok = false;
+    } else if (memcmp(out_new, out_ref, len + RNC_TEST_BUF_PAD) != 0) {
+        LOGERR("%s: unpacked data differs from reference", name);
+        ok = false;
+    } else if ((expect != NULL) && (ret_new != (long)len)) {
+        LOGERR("%s: unpack failed, %s", name, rnc_error(ret_new));
+        ok = false;
+    } else if ((expect != NULL) && (memcmp(out_new, expect, len) != 0)) {
+        LOGERR("%s: unpacked data differs from source", name);
+        ok = false;
+    }
+
+    if (ok && bench)
+    {
+        clock_t start, ticks_new, ticks_ref;
+        ulong reps_new, reps_ref;
+
+        reps_new = 0;
+        start = clock();
+        do {
+            rnc_unpack(packed, out_new, flags);
+            reps_new++;
+        } while (clock() - start < RNC_TEST_BENCH_TICKS);
+        ticks_new = clock() - start;
+
+        reps_ref = 0;
+        start = clock();
+        do {
+            rnc_ref_unpack(packed, out_ref, flags);
+            reps_ref++;
+        } while (clock() - start < RNC_TEST_BENCH_TICKS);
+        ticks_ref = clock() - start;
+
+        printf("%s: %lu bytes, unpack %.1f MB/s, reference %.1f MB/s\n",
+          name, len, bench_mbps(len, reps_new, ticks_new),
+          bench_mbps(len, reps_ref, ticks_ref));
+    }
+    free(out_new);
+    free(out_ref);
+    return ok;
+}
+
+/** Test rnc_crc() against simple bit-by-bit computation.
+ */
+TbBool test_rnc_crc(void)
+{
+    ubyte data[256];
+    ulong len, i;
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = test_rand() & 0xFF;
+    for (len = 0; len < sizeof(data); len++)
+    {
+        ushort val;
+        long crc;
+        int k;
+
+        val = 0;
+        for (i = 0; i < len; i++)
+        {
+            val ^= data[i];
+            for (k = 0; k < 8; k++)
+                val = (val & 1) ? ((val >> 1) ^ 0xA001) : (val >> 1);
+        }
+        crc = rnc_crc(data, len);
+        if (crc != val) {
+            LOGERR("rnc_crc() of %lu bytes is 0x%04lx, expected 0x%04x",
+              len, crc, (uint)val);
+            return false;
+        }
+    }
+    LOGSYNC("passed");
+    return true;
+}
+
+/** Test rnc_unpack() on generated data, packed in various ways.
+ */
+TbBool test_rnc_generated(void)
+{
+    static const ulong lengths[] = {0, 1, 2, 17, 4096, 300000};
+    static const ushort chunk_sizes[] = {2, 7, 4096, 65535};
+    static const char *kind_names[] = {"text", "random", "runs", "mixed"};
+    static const char *huf_names[] = {"optimal", "flat", "skewed"};
+    ubyte *data, *packed;
+    ulong maxlen, packed_size;
+    int li, kind, huf_mode, ci;
+
+    maxlen = lengths[sizeof(lengths)/sizeof(lengths[0]) - 1];
+    packed_size = RNC_HEADER_LEN + maxlen * 2 + 1024;
+    data = (ubyte *)malloc(maxlen + RNC_TEST_BUF_PAD);
+    packed = (ubyte *)malloc(packed_size + RNC_TEST_BUF_PAD);
+    if ((data == NULL) || (packed == NULL)) {
+        LOGERR("cannot allocate buffers");
+        return false;
+    }
+
+    for (li = 0; li < (int)(sizeof(lengths)/sizeof(lengths[0])); li++)
+    for (kind = 0; kind < RnTDat_COUNT; kind++)
+    for (huf_mode = RnTHuf_Optimal; huf_mode <= RnTHuf_Skewed; huf_mode++)
+    for (ci = 0; ci < (int)(sizeof(chunk_sizes)/sizeof(chunk_sizes[0])); ci++)
+    {
+        char name[64];
+        long plen;
+        ulong len;
+        TbBool bench;
+
+        len = lengths[li];
+        sprintf(name, "%s %lu %s chunk %hu", kind_names[kind], len,
+          huf_names[huf_mode], chunk_sizes[ci]);
+        generate_test_data(data, len, kind);
+        plen = rnc_test_pack(data, len, packed, packed_size, huf_mode, chunk_sizes[ci]);
+        if (plen < 0) {
+            LOGERR("%s: packing failed", name);
+            return false;
+        }
+        memset(packed + plen, 0, RNC_TEST_BUF_PAD);
+        bench = (len == maxlen) && (huf_mode == RnTHuf_Optimal) &&
+          (chunk_sizes[ci] == 4096);
+        if (!check_unpack_same(packed, data, len, 0, name, bench))
+            return false;
+
+        // Damaged data must lead to the same result in both unpackers
+        if (plen > RNC_HEADER_LEN + 8)
+        {
+            int n;
+
+            for (n = 0; n < 4; n++)
+            {
+                ulong pos;
+
+                pos = RNC_HEADER_LEN + test_rand() % (plen - RNC_HEADER_LEN);
+                packed[pos] ^= 1 << (test_rand() % 8);
+                strcat(name, " damaged");
+                // Other errors are not ignored, as the unpacker can then
+                // loop over garbage for a very long time
+                if (!check_unpack_same(packed, NULL, len,
+                  RNC_IGNORE_PACKED_CRC_ERROR, name, false))
+                    return false;
+                name[strlen(name) - 8] = '\0';
+            }
+        }
+    }
+
+    free(data);
+    free(packed);
+    LOGSYNC("passed");
+    return true;
+}
+
+/** Test rnc_unpack() on files from disk.
+ * Files which are RNC packed are unpacked and compared to reference,
+ * other files are packed first.
+ */
+TbBool test_rnc_files(int nfiles, char *fnames[])
+{
+    int i;
+
+    for (i = 0; i < nfiles; i++)
+    {
+        FILE *fh;
+        ubyte *data, *packed;
+        long flen;
+        TbBool ok;
+
+        fh = fopen(fnames[i], "rb");
+        if (fh == NULL) {
+            LOGERR("%s: cannot open file", fnames[i]);
+            return false;
+        }
+        fseek(fh, 0, SEEK_END);
+        flen = ftell(fh);
+        fseek(fh, 0, SEEK_SET);
+        data = (ubyte *)malloc(flen + RNC_TEST_BUF_PAD);
+        if ((data == NULL) || (fread(data, 1, flen, fh) != (size_t)flen)) {
+            LOGERR("%s: cannot read file", fnames[i]);
+            fclose(fh);
+            free(data);
+            return false;
+        }
+        fclose(fh);
+        memset(data + flen, 0, RNC_TEST_BUF_PAD);
+
+        if ((flen >= RNC_HEADER_LEN) && (blong(data) == RNC_SIGNATURE))
+        {
+            ok = check_unpack_same(data, NULL, blong(data + 4), 0,
+              fnames[i], true);
+        }
+        else
+        {
+            ulong packed_size;
+            long plen;
+
+            packed_size = RNC_HEADER_LEN + flen * 2 + 1024;
+            packed = (ubyte *)malloc(packed_size + RNC_TEST_BUF_PAD);
+            plen = -1;
+            if (packed != NULL)
+                plen = rnc_test_pack(data, flen, packed, packed_size,
+                  RnTHuf_Optimal, 4096);
+            if (plen < 0) {
+                LOGERR("%s: packing failed", fnames[i]);
+                ok = false;
+            } else {
+                memset(packed + plen, 0, RNC_TEST_BUF_PAD);
+                ok = check_unpack_same(packed, data, flen, 0, fnames[i], true);
+            }
+            free(packed);
+        }
+        free(data);
+        if (!ok)
+            return false;
+    }
+    LOGSYNC("passed");
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (!test_rnc_crc())
+        exit(53);
+    if (!test_rnc_generated())
+        exit(53);
+    if (!test_rnc_files(argc - 1, argv + 1))
+        exit(53);
+    exit(0);
+}
+
+/******************************************************************************/
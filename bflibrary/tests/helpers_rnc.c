@@ -0,0 +1,849 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file helpers_rnc.c
+ *     Implementation of RNC data packing and reference unpacking for tests.
+ * @par Purpose:
+ *     Provides packed data for testing the RNC unpacker, and a reference
+ *     unpacker to compare the results with.
+ * @par Comment:
+ *     The reference unpacker is the original bit-by-bit implementation
+ *     from rnc_1fm.c, before table-driven decoding was introduced.
+ *     The only change is clearing tables at start, so that damaged data
+ *     gives repeatable results.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "helpers_rnc.h"
+#include "bfendian.h"
+#include "rnc_1fm.h"
+#include "bftstlog.h"
+
+/******************************************************************************/
+// Reference unpacker
+
+typedef struct {
+    unsigned long bitbuf;           /* holds between 16 and 32 bits */
+    int bitcount;               /* how many bits does bitbuf hold? */
+} ref_bit_stream;
+
+typedef struct {
+    int num;                   /* number of nodes in the tree */
+    struct {
+    unsigned long code;
+    int codelen;
+    int value;
+    } table[32];
+} ref_huf_table;
+
+/** @internal
+ * Initialises a bit stream with the first two bytes of the packed
+ * data.
+ * Checks pend for proper buffer pointers range.
+ */
+static void ref_bitread_init (ref_bit_stream *bs, unsigned char **p, unsigned char *pend)
+{
+    if (pend-(*p) >= 0)
+        bs->bitbuf = lword (*p);
+    else
+        bs->bitbuf = 0;
+    bs->bitcount = 16;
+}
+
+/** @internal
+ * Fixes up a bit stream after literals have been read out of the
+ * data stream.
+ * Checks pend for proper buffer pointers range.
+ */
+static void ref_bitread_fix (ref_bit_stream *bs, unsigned char **p, unsigned char *pend)
+{
+    bs->bitcount -= 16;
+    bs->bitbuf &= (1<<bs->bitcount)-1; // remove the top 16 bits
+    if (pend-(*p) >= 0)
+        bs->bitbuf |= (lword(*p)<<bs->bitcount);// replace with what's at *p
+    bs->bitcount += 16;
+}
+
+/** @internal
+ * Returns some bits.
+ */
+static unsigned long ref_bit_peek (ref_bit_stream *bs, unsigned long mask)
+{
+    return bs->bitbuf & mask;
+}
+
+/** @internal
+ * Advances the bit stream.
+ * Checks pend for proper buffer pointers range.
+ */
+static void ref_bit_advance (ref_bit_stream *bs, int n, unsigned char **p, unsigned char *pend)
+{
+    bs->bitbuf >>= n;
+    bs->bitcount -= n;
+    if (bs->bitcount < 16)
+    {
+        (*p) += 2;
+        if (pend-(*p) >= 0)
+            bs->bitbuf |= (lword(*p)<<bs->bitcount);
+        bs->bitcount += 16;
+    }
+}
+
+/** @internal
+ * Reads some bits in one go (ie the above two routines combined).
+ */
+static unsigned long ref_bit_read (ref_bit_stream *bs, unsigned long mask,
+                   int n, unsigned char **p, unsigned char *pend)
+{
+    unsigned long result = ref_bit_peek (bs, mask);
+    ref_bit_advance (bs, n, p, pend);
+    return result;
+}
+
+/** @internal
+ * Mirror the bottom n bits of x.
+ */
+static unsigned long ref_mirror (unsigned long x, int n) {
+    unsigned long top = 1 << (n-1), bottom = 1;
+    while (top > bottom)
+    {
+        unsigned long mask = top | bottom;
+        unsigned long masked = x & mask;
+        if (masked != 0 && masked != mask)
+            x ^= mask;
+        top >>= 1;
+        bottom <<= 1;
+    }
+    return x;
+}
+
+/** @internal
+ * Read a Huffman table out of the bit stream and data stream given.
+ */
+static void ref_read_huftable (ref_huf_table *h, ref_bit_stream *bs,
+                          unsigned char **p, unsigned char *pend)
+{
+    int i, j, k, num;
+    int leaflen[32];
+    int leafmax;
+    unsigned long codeb;           // big-endian form of code
+
+    num = ref_bit_read (bs, 0x1F, 5, p, pend);
+    if (!num)
+        return;
+
+    leafmax = 1;
+    for (i=0; i<num; i++)
+    {
+        leaflen[i] = ref_bit_read (bs, 0x0F, 4, p, pend);
+        if (leafmax < leaflen[i])
+            leafmax = leaflen[i];
+    }
+
+    codeb = 0L;
+    k = 0;
+    for (i=1; i<=leafmax; i++)
+    {
+    for (j=0; j<num; j++)
+        if (leaflen[j] == i)
+        {
+            h->table[k].code = ref_mirror (codeb, i);
+            h->table[k].codelen = i;
+            h->table[k].value = j;
+            codeb++;
+            k++;
+        }
+    codeb <<= 1;
+    }
+
+    h->num = k;
+}
+
+/** @internal
+ * Read a value out of the bit stream using the given Huffman table.
+ */
+static long ref_huf_read (ref_huf_table *h, ref_bit_stream *bs,
+                   unsigned char **p,unsigned char *pend)
+{
+    int i;
+    unsigned long val;
+
+    for (i=0; i<h->num; i++)
+    {
+        unsigned long mask = (1 << h->table[i].codelen) - 1;
+        if (ref_bit_peek(bs, mask) == h->table[i].code)
+            break;
+    }
+    if (i == h->num)
+        return -1;
+    ref_bit_advance (bs, h->table[i].codelen, p, pend);
+
+    val = h->table[i].value;
+
+    if (val >= 2)
+    {
+        val = 1 << (val-1);
+        val |= ref_bit_read (bs, val-1, h->table[i].value - 1, p, pend);
+    }
+    return val;
+}
+
+long rnc_ref_unpack(void *packed, void *unpacked, unsigned int flags)
+{
+    unsigned char *input = (unsigned char *)packed;
+    unsigned char *output = (unsigned char *)unpacked;
+    unsigned char *inputend, *outputend;
+    ref_bit_stream bs;
+    ref_huf_table raw, dist, len;
+    unsigned long ch_count;
+    unsigned long ret_len, inp_len;
+    long out_crc;
+    if (blong(input) != RNC_SIGNATURE)
+        if (!(flags & RNC_IGNORE_HEADER_VAL_ERROR)) return RNC_HEADER_VAL_ERROR;
+    ret_len = blong(input+4);
+    inp_len = blong(input+8);
+    if ((ret_len>(1<<30))||(inp_len>(1<<30)))
+        return RNC_HEADER_VAL_ERROR;
+
+    outputend = output + ret_len;
+    inputend = input + 18 + inp_len;
+
+    input += 18;               // skip header
+
+    // Check the packed-data CRC. Also save the unpacked-data CRC
+    // for later.
+
+    if (rnc_crc(input, inputend-input) != (long)bword(input-4))
+        if (!(flags&RNC_IGNORE_PACKED_CRC_ERROR)) return RNC_PACKED_CRC_ERROR;
+    out_crc = bword(input-6);
+
+    // Tables with no codes, in case the first chunk does not define them
+    raw.num = dist.num = len.num = 0;
+
+    ref_bitread_init (&bs, &input, inputend);
+    ref_bit_advance (&bs, 2, &input, inputend);      // discard first two bits
+
+    // Process chunks.
+
+    while (output < outputend)
+    {
+      if (inputend-input < 6)
+      {
+          if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+              return RNC_HUF_EXCEEDS_RANGE;
+          else {
+              output = outputend;
+              ch_count = 0;
+              break;
+          }
+      }
+      ref_read_huftable (&raw,  &bs, &input, inputend);
+      ref_read_huftable (&dist, &bs, &input, inputend);
+      ref_read_huftable (&len,  &bs, &input, inputend);
+      ch_count = ref_bit_read (&bs, 0xFFFF, 16, &input, inputend);
+
+      while (1)
+      {
+        long length, posn;
+
+        length = ref_huf_read (&raw, &bs, &input,inputend);
+        if (length == -1)
+            {
+            if (!(flags & RNC_IGNORE_HUF_DECODE_ERROR))
+                return RNC_HUF_DECODE_ERROR;
+            else
+                {output=outputend;ch_count=0;break;}
+            }
+        if (length)
+        {
+            while (length--)
+            {
+                if ((input >= inputend) || (output >= outputend))
+                {
+                    if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+                        return RNC_HUF_EXCEEDS_RANGE;
+                    else {
+                        output = outputend;
+                        ch_count = 0;
+                        break;
+                    }
+                }
+                *output++ = *input++;
+            }
+            ref_bitread_fix (&bs, &input, inputend);
+        }
+        if (--ch_count <= 0)
+            break;
+
+        posn = ref_huf_read (&dist, &bs, &input,inputend);
+        if (posn == -1)
+        {
+            if (!(flags&RNC_IGNORE_HUF_DECODE_ERROR))
+                return RNC_HUF_DECODE_ERROR;
+            else
+                {output=outputend;ch_count=0;break;}
+        }
+        length = ref_huf_read (&len, &bs, &input,inputend);
+        if (length == -1)
+        {
+            if (!(flags&RNC_IGNORE_HUF_DECODE_ERROR))
+                return RNC_HUF_DECODE_ERROR;
+            else
+                {output=outputend;ch_count=0;break;}
+        }
+        posn += 1;
+        length += 2;
+        while (length--)
+        {
+            if (((output-posn) < (unsigned char *)unpacked)
+             || ((output-posn) > (unsigned char *)outputend)
+             || ((output) < (unsigned char *)unpacked)
+             || ((output) > (unsigned char *)outputend))
+            {
+                   if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+                       return RNC_HUF_EXCEEDS_RANGE;
+                   else {
+                       output = outputend-1;
+                       ch_count = 0;
+                       break;
+                   }
+            }
+            *output = output[-posn];
+            output++;
+        }
+      }
+    }
+
+    if (outputend != output)
+    {
+        if (!(flags & RNC_IGNORE_FILE_SIZE_MISMATCH))
+            return RNC_FILE_SIZE_MISMATCH;
+    }
+
+
+    // Check the unpacked-data CRC.
+
+    if (rnc_crc(outputend-ret_len, ret_len) != out_crc)
+    {
+        if (!(flags & RNC_IGNORE_UNPACKED_CRC_ERROR))
+            return RNC_UNPACKED_CRC_ERROR;
+    }
+
+    return ret_len;
+}
+
+/******************************************************************************/
+// Packer
+
+/** Amount of data which matches can reach back to. */
+#define RNC_TEST_WINDOW 65535
+#define RNC_TEST_MATCH_MIN 2
+#define RNC_TEST_MATCH_MAX 1024
+/** Longest literal run; values need to fit in a code and 15 extra bits. */
+#define RNC_TEST_LITERAL_MAX 65535
+#define RNC_TEST_HASH_BITS 13
+#define RNC_TEST_CHAIN_MAX 32
+
+struct RncTestToken {
+    ulong LitLen;
+    ulong Dist;
+    ulong Len;
+};
+
+struct RncTestWriter {
+    ubyte *Buf;
+    ulong Size;
+    ulong Pos;
+    ulong WordPos;
+    int WordBits;
+    TbBool Overflow;
+};
+
+struct RncTestCodes {
+    int Num;
+    int Len[32];
+    ulong Code[32];
+};
+
+/** Writes bits into the stream, lowest first.
+ *
+ * Next 16-bit word is only reserved when there is a bit to put into it;
+ * this is how the unpacker expects literal bytes and words to interleave.
+ */
+static void rnc_test_write_bits(struct RncTestWriter *w, ulong val, int n)
+{
+    while (n > 0)
+    {
+        ulong word;
+        int take;
+
+        if (w->WordBits == 16) {
+            if (w->Pos + 2 > w->Size) {
+                w->Overflow = true;
+                return;
+            }
+            w->WordPos = w->Pos;
+            w->Buf[w->Pos++] = 0;
+            w->Buf[w->Pos++] = 0;
+            w->WordBits = 0;
+        }
+        take = 16 - w->WordBits;
+        if (take > n)
+            take = n;
+        word = w->Buf[w->WordPos] | (w->Buf[w->WordPos + 1] << 8);
+        word |= (val & ((1 << take) - 1)) << w->WordBits;
+        w->Buf[w->WordPos] = word & 0xFF;
+        w->Buf[w->WordPos + 1] = (word >> 8) & 0xFF;
+        val >>= take;
+        n -= take;
+        w->WordBits += take;
+    }
+}
+
+static void rnc_test_write_bytes(struct RncTestWriter *w, const ubyte *data, ulong len)
+{
+    if (w->Pos + len > w->Size) {
+        w->Overflow = true;
+        return;
+    }
+    memcpy(&w->Buf[w->Pos], data, len);
+    w->Pos += len;
+}
+
+/** Gives symbol which stores given value; the rest is stored as extra bits.
+ */
+static int rnc_test_value_symbol(ulong val)
+{
+    int sym;
+
+    if (val < 2)
+        return val;
+    sym = 0;
+    while ((val >> sym) != 0)
+        sym++;
+    return sym;
+}
+
+static ulong rnc_test_mirror(ulong x, int n)
+{
+    ulong r;
+    int i;
+
+    r = 0;
+    for (i = 0; i < n; i++)
+        r |= ((x >> i) & 1) << (n - 1 - i);
+    return r;
+}
+
+/** Computes Huffman code lengths; returns max length.
+ */
+static int rnc_test_huffman_lengths(const ulong *freq, int num, int *lens)
+{
+    ulong weight[64];
+    int parent[64];
+    TbBool merged[64];
+    int nodes, i, maxlen;
+
+    nodes = num;
+    for (i = 0; i < num; i++) {
+        weight[i] = freq[i];
+        parent[i] = -1;
+        merged[i] = (freq[i] == 0);
+    }
+    while (1)
+    {
+        int m1, m2;
+
+        m1 = -1;
+        m2 = -1;
+        for (i = 0; i < nodes; i++)
+        {
+            if (merged[i])
+                continue;
+            if ((m1 < 0) || (weight[i] < weight[m1])) {
+                m2 = m1;
+                m1 = i;
+            } else if ((m2 < 0) || (weight[i] < weight[m2])) {
+                m2 = i;
+            }
+        }
+        if (m2 < 0)
+            break;
+        weight[nodes] = weight[m1] + weight[m2];
+        parent[nodes] = -1;
+        merged[nodes] = false;
+        parent[m1] = nodes;
+        parent[m2] = nodes;
+        merged[m1] = true;
+        merged[m2] = true;
+        nodes++;
+    }
+    maxlen = 0;
+    for (i = 0; i < num; i++)
+    {
+        int k, len;
+
+        lens[i] = 0;
+        if (freq[i] == 0)
+            continue;
+        len = 0;
+        for (k = i; parent[k] >= 0; k = parent[k])
+            len++;
+        if (len == 0)
+            len = 1;
+        lens[i] = len;
+        if (maxlen < len)
+            maxlen = len;
+    }
+    return maxlen;
+}
+
+/** Selects code lengths for symbols, and computes the codes the same
+ * way the unpacker does.
+ */
+static void rnc_test_make_codes(struct RncTestCodes *c, const ulong *freq, int huf_mode)
+{
+    int i, k, used, maxlen;
+    ulong codeb;
+
+    c->Num = 0;
+    used = 0;
+    for (i = 0; i < 32; i++) {
+        c->Len[i] = 0;
+        if (freq[i] != 0) {
+            c->Num = i + 1;
+            used++;
+        }
+    }
+    if (used == 0) {
+        // Unpacker needs a valid table even if it is never used
+        c->Num = 1;
+        c->Len[0] = 1;
+        c->Code[0] = 0;
+        return;
+    }
+
+    maxlen = 16;
+    if (huf_mode == RnTHuf_Optimal) {
+        maxlen = rnc_test_huffman_lengths(freq, c->Num, c->Len);
+    } else if ((huf_mode == RnTHuf_Skewed) && (used <= 16)) {
+        TbBool done[32];
+
+        // Most frequent symbol gets the shortest code
+        for (i = 0; i < 32; i++)
+            done[i] = (freq[i] == 0);
+        for (k = 1; k <= used; k++)
+        {
+            int best;
+
+            best = -1;
+            for (i = 0; i < c->Num; i++) {
+                if (done[i])
+                    continue;
+                if ((best < 0) || (freq[i] > freq[best]))
+                    best = i;
+            }
+            c->Len[best] = (k < used) ? k : k - 1;
+            if (c->Len[best] == 0)
+                c->Len[best] = 1;
+            done[best] = true;
+        }
+        maxlen = used - 1;
+    }
+    if ((huf_mode == RnTHuf_Flat) || (maxlen > 15))
+    {
+        int len;
+
+        len = 1;
+        while ((1 << len) < used)
+            len++;
+        for (i = 0; i < c->Num; i++)
+            c->Len[i] = (freq[i] != 0) ? len : 0;
+    }
+
+    codeb = 0;
+    for (k = 1; k <= 15; k++)
+    {
+        for (i = 0; i < c->Num; i++)
+        {
+            if (c->Len[i] != k)
+                continue;
+            c->Code[i] = rnc_test_mirror(codeb, k);
+            codeb++;
+        }
+        codeb <<= 1;
+    }
+}
+
+static void rnc_test_write_table(struct RncTestWriter *w, const struct RncTestCodes *c)
+{
+    int i;
+
+    rnc_test_write_bits(w, c->Num, 5);
+    for (i = 0; i < c->Num; i++)
+        rnc_test_write_bits(w, c->Len[i], 4);
+}
+
+static void rnc_test_write_value(struct RncTestWriter *w, const struct RncTestCodes *c, ulong val)
+{
+    int sym;
+
+    sym = rnc_test_value_symbol(val);
+    rnc_test_write_bits(w, c->Code[sym], c->Len[sym]);
+    if (sym >= 2)
+        rnc_test_write_bits(w, val - (1 << (sym - 1)), sym - 1);
+}
+
+static ulong rnc_test_hash(const ubyte *p)
+{
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & ((1 << RNC_TEST_HASH_BITS) - 1);
+}
+
+/** Finds the longest match for given position; returns its length.
+ */
+static ulong rnc_test_find_match(const ubyte *data, ulong len, ulong pos,
+  const long *head, const long *prev, ulong *p_dist)
+{
+    static const ulong short_dists[] = {1, 2, 3, 4, 7, 8, 9};
+    ulong best_len, limit;
+    long cand;
+    int i, chain;
+
+    best_len = 0;
+    limit = len - pos;
+    if (limit > RNC_TEST_MATCH_MAX)
+        limit = RNC_TEST_MATCH_MAX;
+    if (limit < RNC_TEST_MATCH_MIN)
+        return 0;
+
+    for (i = 0; i < (int)(sizeof(short_dists)/sizeof(short_dists[0])); i++)
+    {
+        ulong dist, n;
+
+        dist = short_dists[i];
+        if (dist > pos)
+            break;
+        for (n = 0; n < limit; n++)
+            if (data[pos + n] != data[pos + n - dist])
+                break;
+        if (n > best_len) {
+            best_len = n;
+            *p_dist = dist;
+        }
+    }
+
+    if (limit < 3)
+        return (best_len >= RNC_TEST_MATCH_MIN) ? best_len : 0;
+    cand = head[rnc_test_hash(&data[pos])];
+    for (chain = 0; (cand >= 0) && (chain < RNC_TEST_CHAIN_MAX); chain++)
+    {
+        ulong dist, n;
+
+        dist = pos - cand;
+        if (dist > RNC_TEST_WINDOW)
+            break;
+        for (n = 0; n < limit; n++)
+            if (data[pos + n] != data[cand + n])
+                break;
+        if (n > best_len) {
+            best_len = n;
+            *p_dist = dist;
+        }
+        cand = prev[cand];
+    }
+    return (best_len >= RNC_TEST_MATCH_MIN) ? best_len : 0;
+}
+
+/** Splits data into tokens - literal runs, each followed by a match.
+ * Returns amount of tokens; last one has no match, and there may be
+ * more without a match if literal runs were too long.
+ */
+static ulong rnc_test_tokenize(const ubyte *data, ulong len, struct RncTestToken *tokens)
+{
+    long head[1 << RNC_TEST_HASH_BITS];
+    long *prev;
+    ulong pos, lit_start, ntokens;
+
+    prev = (long *)malloc(sizeof(long) * (len + 1));
+    if (prev == NULL)
+        return 0;
+    for (pos = 0; pos < (1 << RNC_TEST_HASH_BITS); pos++)
+        head[pos] = -1;
+
+    ntokens = 0;
+    lit_start = 0;
+    pos = 0;
+    while (pos < len)
+    {
+        ulong mlen, dist, i;
+
+        if (pos - lit_start >= RNC_TEST_LITERAL_MAX) {
+            // Token without match, which will end the chunk
+            tokens[ntokens].LitLen = pos - lit_start;
+            tokens[ntokens].Dist = 0;
+            tokens[ntokens].Len = 0;
+            ntokens++;
+            lit_start = pos;
+        }
+        dist = 0;
+        mlen = rnc_test_find_match(data, len, pos, head, prev, &dist);
+        if (mlen == 0) {
+            mlen = 1;
+            dist = 0;
+        }
+        for (i = 0; i < mlen; i++) {
+            if (pos + i + 2 < len) {
+                ulong h = rnc_test_hash(&data[pos + i]);
+                prev[pos + i] = head[h];
+                head[h] = pos + i;
+            }
+        }
+        if (dist != 0) {
+            tokens[ntokens].LitLen = pos - lit_start;
+            tokens[ntokens].Dist = dist;
+            tokens[ntokens].Len = mlen;
+            ntokens++;
+            lit_start = pos + mlen;
+        }
+        pos += mlen;
+    }
+    tokens[ntokens].LitLen = pos - lit_start;
+    tokens[ntokens].Dist = 0;
+    tokens[ntokens].Len = 0;
+    ntokens++;
+    free(prev);
+    return ntokens;
+}
+
+static void rnc_test_store_blong(ubyte *p, ulong val)
+{
+    p[0] = (val >> 24) & 0xFF;
+    p[1] = (val >> 16) & 0xFF;
+    p[2] = (val >> 8) & 0xFF;
+    p[3] = val & 0xFF;
+}
+
+long rnc_test_pack(const ubyte *data, ulong len, ubyte *packed,
+  ulong packed_size, int huf_mode, ushort chunk_tokens)
+{
+    struct RncTestWriter w;
+    struct RncTestToken *tokens, *chunk;
+    ulong ntokens, tk, inp_pos, chunks;
+    ulong ucrc, pcrc;
+
+    if ((packed_size < RNC_HEADER_LEN) || (chunk_tokens < 2))
+        return -1;
+    tokens = (struct RncTestToken *)malloc(sizeof(struct RncTestToken) * (len + 1));
+    chunk = (struct RncTestToken *)malloc(sizeof(struct RncTestToken) * chunk_tokens);
+    if ((tokens == NULL) || (chunk == NULL)) {
+        free(tokens);
+        free(chunk);
+        return -1;
+    }
+    ntokens = rnc_test_tokenize(data, len, tokens);
+
+    w.Buf = packed + RNC_HEADER_LEN;
+    w.Size = packed_size - RNC_HEADER_LEN;
+    w.Pos = 0;
+    w.WordPos = 0;
+    w.WordBits = 16;
+    w.Overflow = false;
+    // Lock and key flags
+    rnc_test_write_bits(&w, 0, 2);
+
+    chunks = 0;
+    inp_pos = 0;
+    tk = 0;
+    // Each chunk gets up to chunk_tokens literal runs, and ends on a token
+    // without match; if the limit is reached on a token with match, the
+    // match is moved to start of next chunk
+    while ((len > 0) && (tk < ntokens))
+    {
+        struct RncTestCodes raw_c, dist_c, len_c;
+        ulong raw_f[32], dist_f[32], len_f[32];
+        ulong i, n;
+
+        n = 0;
+        while ((n < chunk_tokens) && (tk < ntokens))
+        {
+            chunk[n] = tokens[tk];
+            n++;
+            if (tokens[tk].Dist == 0) {
+                tk++;
+                break;
+            }
+            if (n == chunk_tokens) {
+                // Split the match away into a token without literals
+                chunk[n-1].Dist = 0;
+                chunk[n-1].Len = 0;
+                tokens[tk].LitLen = 0;
+                break;
+            }
+            tk++;
+        }
+
+        memset(raw_f, 0, sizeof(raw_f));
+        memset(dist_f, 0, sizeof(dist_f));
+        memset(len_f, 0, sizeof(len_f));
+        for (i = 0; i < n; i++)
+        {
+            raw_f[rnc_test_value_symbol(chunk[i].LitLen)]++;
+            if (i + 1 < n) {
+                dist_f[rnc_test_value_symbol(chunk[i].Dist - 1)]++;
+                len_f[rnc_test_value_symbol(chunk[i].Len - RNC_TEST_MATCH_MIN)]++;
+            }
+        }
+        rnc_test_make_codes(&raw_c, raw_f, huf_mode);
+        rnc_test_make_codes(&dist_c, dist_f, huf_mode);
+        rnc_test_make_codes(&len_c, len_f, huf_mode);
+        rnc_test_write_table(&w, &raw_c);
+        rnc_test_write_table(&w, &dist_c);
+        rnc_test_write_table(&w, &len_c);
+        rnc_test_write_bits(&w, n, 16);
+
+        for (i = 0; i < n; i++)
+        {
+            rnc_test_write_value(&w, &raw_c, chunk[i].LitLen);
+            if (chunk[i].LitLen != 0) {
+                rnc_test_write_bytes(&w, &data[inp_pos], chunk[i].LitLen);
+                inp_pos += chunk[i].LitLen;
+            }
+            if (i + 1 < n) {
+                rnc_test_write_value(&w, &dist_c, chunk[i].Dist - 1);
+                rnc_test_write_value(&w, &len_c, chunk[i].Len - RNC_TEST_MATCH_MIN);
+                inp_pos += chunk[i].Len;
+            }
+        }
+        chunks++;
+    }
+    free(chunk);
+    free(tokens);
+    // Unpacker requires some data left when it starts each chunk
+    rnc_test_write_bytes(&w, (const ubyte *)"\0\0\0\0\0\0", 6);
+    if (w.Overflow || (inp_pos != len))
+        return -1;
+
+    ucrc = rnc_crc((void *)data, len);
+    pcrc = rnc_crc(w.Buf, w.Pos);
+    rnc_test_store_blong(packed + 0, RNC_SIGNATURE);
+    rnc_test_store_blong(packed + 4, len);
+    rnc_test_store_blong(packed + 8, w.Pos);
+    packed[12] = (ucrc >> 8) & 0xFF;
+    packed[13] = ucrc & 0xFF;
+    packed[14] = (pcrc >> 8) & 0xFF;
+    packed[15] = pcrc & 0xFF;
+    packed[16] = 0;
+    packed[17] = (chunks > 255) ? 255 : chunks;
+    return RNC_HEADER_LEN + w.Pos;
+}
+
+/******************************************************************************/
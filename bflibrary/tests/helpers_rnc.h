@@ -0,0 +1,69 @@
+/******************************************************************************/
+// Bullfrog Engine Emulation Library - for use to remake classic games like
+// Syndicate Wars, Magic Carpet, Genewars or Dungeon Keeper.
+/******************************************************************************/
+/** @file helpers_rnc.h
+ *     Header file for helpers_rnc.c.
+ * @par Purpose:
+ *     Implementation of RNC data packing and reference unpacking for tests.
+ * @par Comment:
+ *     None.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef HELPERS_RNC_H_
+#define HELPERS_RNC_H_
+
+#include "bftypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Ways of selecting Huffman code lengths when packing.
+ */
+enum RncTestHufMode {
+    /** Optimal Huffman code lengths, as a real packer would use. */
+    RnTHuf_Optimal = 0,
+    /** Same length for all symbols used within a table. */
+    RnTHuf_Flat,
+    /** Each next symbol one bit longer, to get codes of up to 15 bits. */
+    RnTHuf_Skewed,
+};
+
+/** Packs data into RNC-1 format.
+ *
+ * The packer is simple and slow, but produces valid files which use
+ * all features of the format - multiple chunks, long and overlapping
+ * matches, literal runs and codes of all lengths.
+ *
+ * @param data Input buffer.
+ * @param len Input length.
+ * @param packed Output buffer, including space for RNC header.
+ * @param packed_size Size of the output buffer.
+ * @param huf_mode Way of selecting code lengths, one of RncTestHufMode.
+ * @param chunk_tokens Max amount of literal runs within one chunk.
+ * @return Length of the packed file, or -1 if it did not fit the buffer.
+ */
+long rnc_test_pack(const ubyte *data, ulong len, ubyte *packed,
+  ulong packed_size, int huf_mode, ushort chunk_tokens);
+
+/** Reference RNC-1 unpacker, decoding every code by scanning tables.
+ *
+ * Copy of the original straightforward implementation, used to make sure
+ * the optimized one gives identical results.
+ */
+long rnc_ref_unpack(void *packed, void *unpacked, unsigned int flags);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // HELPERS_RNC_H_
+/******************************************************************************/
@@ -27,6 +27,7 @@
 #include "enginsngtxtr.h"
 
 #include "game_data.h"
+#include "thing_grid.h"
 #include "swlog.h"
 /******************************************************************************/
 const struct Direction angle_direction[] = {
@@ -95,6 +96,7 @@ void clear_mapwho_on_whole_map(void)
             p_mapel->Child = 0;
         }
     }
+    thing_grid_invalidate();
 }
 
 short get_mapwho_thing_index(short tile_x, short tile_z)
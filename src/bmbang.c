@@ -19,6 +19,7 @@
 #include "bmbang.h"
 
 #include "thing.h"
+#include "thing_sight.h"
 #include "swlog.h"
 /******************************************************************************/
 
@@ -84,6 +85,8 @@ void do_shockwave(int x, int y, int z, int radius, int intensity, struct Thing *
       "push %4\n"
       "call ASM_do_shockwave\n"
         : : "a" (x), "d" (y), "b" (z), "c" (radius), "g" (intensity), "g" (p_owner));
+    // Things within the range may lose their collision vectors
+    thing_sight_memo_clear();
 }
 
 
@@ -35,6 +35,7 @@
 #include "matrix.h"
 #include "sound.h"
 #include "thing.h"
+#include "thing_sight.h"
 #include "tngcolisn.h"
 #include "vehtraffic.h"
 #include "weapon.h"
@@ -254,6 +255,8 @@ ushort explode_thing_building(short thing, short x, short y, short z)
     asm volatile (
       "call ASM_explode_thing_building\n"
         : "=r" (ret) : "a" (thing), "d" (x), "b" (y), "c" (z));
+    // Collision vectors of the building were removed
+    thing_sight_memo_clear();
     return ret;
 }
 
@@ -472,6 +475,7 @@ void collapse_building(short x, short y, short z, struct Thing *p_building)
     short thing;
     int i;
 
+    thing_sight_memo_clear();
     if (ingame.SoundThing != 0)
     {
         p_sthing = &sthings[ingame.SoundThing];
@@ -20,10 +20,12 @@
 
 #include "bfendian.h"
 #include "bfmath.h"
+#include "bfmemory.h"
 #include "bfmemut.h"
 #include "bfutility.h"
 #include <assert.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "enginbckt.h"
@@ -811,11 +813,286 @@ enum DrawObjectFacesFlags {
     DrwObjF_StartBelowWindow = 0x0200,
 };
 
+/** Camera state which transform_shpoint() results depend on.
+ */
+struct ObjPointsViewKey {
+    s32 RotA;
+    s32 RotB;
+    s32 RotC;
+    s32 RotD;
+    s32 CenterX;
+    s32 CenterY;
+    s32 CamY;
+    s32 WindowW;
+    s32 WindowH;
+    ushort Scale;
+    ubyte Perspective;
+};
+
+/** Position of a static object for which its cached points were computed.
+ */
+struct ObjPointsCacheObj {
+    ulong ViewStamp;
+    s32 CorDX;
+    s32 CorDY;
+    s32 CorDZ;
+};
+
+/** Cached screen position of a static object point.
+ */
+struct ObjPointsCachePt {
+    short SrcX;
+    short SrcY;
+    short SrcZ;
+    ubyte Flags;
+    struct SpecialPoint Scr;
+};
+
+/** Screen points of static objects, reused while the camera does not move.
+ * Source coordinates of each point are stored and compared, so objects
+ * modified in any way (ie. collapsing buildings) are transformed again.
+ */
+static struct ObjPointsCacheObj *obj_points_cache_objs = NULL;
+static struct ObjPointsCachePt *obj_points_cache_pts = NULL;
+static s32 obj_points_cache_objs_count = 0;
+static s32 obj_points_cache_pts_count = 0;
+static struct ObjPointsViewKey obj_points_view_key;
+static ulong obj_points_view_stamp = 1;
+
+static TbBool obj_points_cache_alloc(void)
+{
+    if ((obj_points_cache_objs_count == game_objects_limit) &&
+      (obj_points_cache_pts_count == game_object_points_limit))
+        return (obj_points_cache_objs != NULL) && (obj_points_cache_pts != NULL);
+
+    LbMemoryFree(obj_points_cache_objs);
+    LbMemoryFree(obj_points_cache_pts);
+    obj_points_cache_objs_count = game_objects_limit;
+    obj_points_cache_pts_count = game_object_points_limit;
+    obj_points_cache_objs = LbMemoryAlloc(sizeof(struct ObjPointsCacheObj) * obj_points_cache_objs_count);
+    obj_points_cache_pts = LbMemoryAlloc(sizeof(struct ObjPointsCachePt) * obj_points_cache_pts_count);
+    if ((obj_points_cache_objs == NULL) || (obj_points_cache_pts == NULL)) {
+        LOGWARN("Cannot allocate static object points cache");
+        return false;
+    }
+    LbMemorySet(obj_points_cache_objs, 0, sizeof(struct ObjPointsCacheObj) * obj_points_cache_objs_count);
+    return true;
+}
+
+/** Checks if the camera changed since last call; if it did, cached points
+ * of all objects become outdated.
+ */
+static void obj_points_view_update(void)
+{
+    struct ObjPointsViewKey key;
+
+    LbMemorySet(&key, 0, sizeof(key));
+    key.RotA = dword_176D10;
+    key.RotB = dword_176D14;
+    key.RotC = dword_176D18;
+    key.RotD = dword_176D1C;
+    key.CenterX = dword_176D3C;
+    key.CenterY = dword_176D40;
+    key.CamY = engn_yc;
+    key.WindowW = vec_window_width;
+    key.WindowH = vec_window_height;
+    key.Scale = overall_scale;
+    key.Perspective = game_perspective;
+    if (memcmp(&key, &obj_points_view_key, sizeof(key)) != 0) {
+        obj_points_view_key = key;
+        obj_points_view_stamp++;
+    }
+}
+
+/** Gives cache entry of the object if it is usable; returns NULL otherwise.
+ * @param p_valid Set to whether points cached for the object are up to date.
+ */
+static struct ObjPointsCacheObj *obj_points_cache_get(struct SingleObject *point_object,
+  int cor_dx, int cor_dy, int cor_dz, TbBool *p_valid)
+{
+    struct ObjPointsCacheObj *p_ocobj;
+    long obj;
+
+    *p_valid = false;
+    if (!obj_points_cache_alloc())
+        return NULL;
+    obj = point_object - game_objects;
+    if ((obj < 0) || (obj >= obj_points_cache_objs_count))
+        return NULL;
+    if (point_object->EndPoint >= obj_points_cache_pts_count)
+        return NULL;
+
+    obj_points_view_update();
+    p_ocobj = &obj_points_cache_objs[obj];
+    *p_valid = (p_ocobj->ViewStamp == obj_points_view_stamp)
+      && (p_ocobj->CorDX == cor_dx) && (p_ocobj->CorDY == cor_dy)
+      && (p_ocobj->CorDZ == cor_dz);
+    p_ocobj->ViewStamp = obj_points_view_stamp;
+    p_ocobj->CorDX = cor_dx;
+    p_ocobj->CorDY = cor_dy;
+    p_ocobj->CorDZ = cor_dz;
+    return p_ocobj;
+}
+
+/** Amount of object points transformed together by transform_shpoints().
+ */
+#define OBJECT_POINTS_BATCH_LEN 256
+
+static s32 batch_dxc[OBJECT_POINTS_BATCH_LEN];
+static s32 batch_dyc[OBJECT_POINTS_BATCH_LEN];
+static s32 batch_dzc[OBJECT_POINTS_BATCH_LEN];
+static ushort batch_snpoint[OBJECT_POINTS_BATCH_LEN];
+static struct ShEnginePoint batch_sp[OBJECT_POINTS_BATCH_LEN];
+
+/** Transforms the queued object points, and stores them in screen points
+ * pool and in the points cache.
+ */
+static void object_points_batch_transform(struct ObjPointsCacheObj *p_ocobj,
+  int batch_len)
+{
+    int i;
+
+    transform_shpoints(batch_dxc, batch_dyc, batch_dzc, batch_sp, batch_len);
+
+    for (i = 0; i < batch_len; i++)
+    {
+        struct SinglePoint *p_snpoint;
+        struct SpecialPoint *p_specpt;
+        struct ShEnginePoint *p_sp;
+
+        p_sp = &batch_sp[i];
+        p_snpoint = &game_object_points[batch_snpoint[i]];
+        p_specpt = &game_screen_point_pool[p_snpoint->PointOffset];
+
+        p_specpt->X = p_sp->X;
+        p_specpt->Y = p_sp->Y;
+        p_specpt->Z = p_sp->Depth;
+        p_snpoint->Flags = p_sp->Flags;
+
+        if (p_ocobj != NULL) {
+            struct ObjPointsCachePt *p_ocpt;
+
+            p_ocpt = &obj_points_cache_pts[batch_snpoint[i]];
+            p_ocpt->SrcX = p_snpoint->X;
+            p_ocpt->SrcY = p_snpoint->Y;
+            p_ocpt->SrcZ = p_snpoint->Z;
+            p_ocpt->Flags = p_sp->Flags;
+            p_ocpt->Scr = *p_specpt;
+        }
+    }
+}
+
+/** Max distance from camera at which object box can be checked for culling.
+ * Above that, transform_shpoint() computations overflow and points wrap
+ * around, so the projected box would not bound them.
+ */
+#define OBJECT_CULL_COORD_LIMIT 0x4800
+
+/** Checks whether all points of a static object fall outside of the view
+ * window, on the same side.
+ *
+ * Faces of such object would all be rejected by their points clipping flags,
+ * so there is no need to transform its points. The projection is linear
+ * (except for perspective 5), so the bounding box of object points projected
+ * to screen bounds the projected points; margins cover rounding.
+ */
+static TbBool object_outside_view_window(int cor_dx, int cor_dy, int cor_dz,
+  struct SingleObject *point_object)
+{
+    int min_x, min_y, min_z, max_x, max_y, max_z;
+    int dxc, dyc, dzc, ext_x, ext_y, ext_z;
+    s64 fctr_a, fctr_b, fctr_c, ext_a, ext_b, ext_c;
+    s64 scr_x, scr_y, ext_scr_x, ext_scr_y;
+    int snpoint;
+    int i, face;
+
+    if (game_perspective == 5)
+        return false;
+
+    min_x = min_y = min_z = INT_MAX;
+    max_x = max_y = max_z = INT_MIN;
+    for (snpoint = point_object->StartPoint; snpoint <= point_object->EndPoint; snpoint++)
+    {
+        struct SinglePoint *p_snpoint;
+
+        p_snpoint = &game_object_points[snpoint];
+        if (min_x > p_snpoint->X) min_x = p_snpoint->X;
+        if (max_x < p_snpoint->X) max_x = p_snpoint->X;
+        if (min_y > p_snpoint->Y) min_y = p_snpoint->Y;
+        if (max_y < p_snpoint->Y) max_y = p_snpoint->Y;
+        if (min_z > p_snpoint->Z) min_z = p_snpoint->Z;
+        if (max_z < p_snpoint->Z) max_z = p_snpoint->Z;
+    }
+    // Poles transform their own points, which may be outside the range
+    face = point_object->StartFace4;
+    for (i = 0; i < point_object->NumbFaces4; i++, face++)
+    {
+        struct SingleObjectFace4 *p_face4;
+        int k;
+
+        p_face4 = &game_object_faces4[face];
+        if ((p_face4->GFlags & FGFlg_Unkn08) == 0)
+            continue;
+        for (k = 0; k < 2; k++)
+        {
+            struct SinglePoint *p_snpoint;
+
+            p_snpoint = &game_object_points[p_face4->PointNo[k]];
+            if (min_x > p_snpoint->X) min_x = p_snpoint->X;
+            if (max_x < p_snpoint->X) max_x = p_snpoint->X;
+            if (min_y > p_snpoint->Y) min_y = p_snpoint->Y;
+            if (max_y < p_snpoint->Y) max_y = p_snpoint->Y;
+            if (min_z > p_snpoint->Z) min_z = p_snpoint->Z;
+            if (max_z < p_snpoint->Z) max_z = p_snpoint->Z;
+        }
+    }
+    if (min_x > max_x)
+        return false;
+
+    dxc = cor_dx + (min_x + max_x) / 2;
+    dyc = cor_dy + (min_y + max_y) / 2 - 8 * engn_yc;
+    dzc = cor_dz + (min_z + max_z) / 2;
+    ext_x = (max_x - min_x) / 2 + 1;
+    ext_y = (max_y - min_y) / 2 + 1;
+    ext_z = (max_z - min_z) / 2 + 1;
+
+    if ((abs(dxc) + ext_x > OBJECT_CULL_COORD_LIMIT) ||
+      (abs(dyc) + ext_y > OBJECT_CULL_COORD_LIMIT) ||
+      (abs(dzc) + ext_z > OBJECT_CULL_COORD_LIMIT))
+        return false;
+
+    // Box centre, transformed the same way as in transform_shpoint()
+    fctr_a = ((s64)dword_176D14 * dxc - (s64)dword_176D10 * dzc) >> 16;
+    fctr_b = ((s64)dword_176D10 * dxc + (s64)dword_176D14 * dzc) >> 16;
+    fctr_c = ((s64)dword_176D1C * dyc - (s64)dword_176D18 * fctr_b) >> 16;
+    // Box extents after the same transformation, with margin for rounding
+    ext_a = (((s64)abs(dword_176D14) * ext_x + (s64)abs(dword_176D10) * ext_z) >> 16) + 2;
+    ext_b = (((s64)abs(dword_176D10) * ext_x + (s64)abs(dword_176D14) * ext_z) >> 16) + 2;
+    ext_c = (((s64)abs(dword_176D1C) * ext_y + (s64)abs(dword_176D18) * ext_b) >> 16) + 2;
+
+    scr_x = dword_176D3C + ((overall_scale * fctr_a) >> 11);
+    scr_y = dword_176D40 - ((overall_scale * fctr_c) >> 11);
+    ext_scr_x = ((overall_scale * ext_a) >> 11) + 2;
+    ext_scr_y = ((overall_scale * ext_c) >> 11) + 2;
+
+    if (scr_x + ext_scr_x < 0)
+        return true;
+    if (scr_x - ext_scr_x >= vec_window_width)
+        return true;
+    if (scr_y + ext_scr_y < 0)
+        return true;
+    if (scr_y - ext_scr_y >= vec_window_height)
+        return true;
+    return false;
+}
+
 short draw_object_faces(int cor_dx, int cor_dy, int cor_dz,
   struct SingleObject *point_object, ushort doflags)
 {
-    struct ShEnginePoint sp1;
+    struct ObjPointsCacheObj *p_ocobj;
+    TbBool cache_valid;
     int i, bckt_max;
+    int batch_len;
     int face_beg, face;
     int snpoint;
     int points_num;
@@ -829,37 +1106,51 @@ short draw_object_faces(int cor_dx, int cor_dy, int cor_dz,
 
     bckt_max = 0;
 
+    if (object_outside_view_window(cor_dx, cor_dy, cor_dz, point_object))
+        return bckt_max;
+
     // Make sure we have enough free points to start drawing the object
     points_num = point_object->EndPoint - point_object->StartPoint;
     if (next_screen_point + 1 * points_num > screen_points_limit)
         return 0;
 
+    p_ocobj = obj_points_cache_get(point_object, cor_dx, cor_dy, cor_dz, &cache_valid);
+
+    batch_len = 0;
     for (snpoint = point_object->StartPoint; snpoint <= point_object->EndPoint; snpoint++)
     {
         struct SinglePoint *p_snpoint;
-        struct SpecialPoint *p_specpt;
-        {
-            int specpt;
-            int dxc, dyc, dzc;
+        struct ObjPointsCachePt *p_ocpt;
+        int specpt;
 
-            specpt = next_screen_point;
-            next_screen_point++;
+        specpt = next_screen_point;
+        next_screen_point++;
 
-            p_snpoint = &game_object_points[snpoint];
-            dxc = p_snpoint->X + cor_dx;
-            dzc = p_snpoint->Z + cor_dz;
-            dyc = p_snpoint->Y + cor_dy;
-            transform_shpoint(&sp1, dxc, dyc - 8 * engn_yc, dzc);
+        p_snpoint = &game_object_points[snpoint];
+        p_snpoint->PointOffset = specpt + 0;
+        p_ocpt = (p_ocobj != NULL) ? &obj_points_cache_pts[snpoint] : NULL;
 
-            p_specpt = &game_screen_point_pool[specpt];
-            p_specpt->X = sp1.X;
-            p_specpt->Y = sp1.Y;
-            p_specpt->Z = sp1.Depth;
+        if (cache_valid && (p_ocpt->SrcX == p_snpoint->X) &&
+          (p_ocpt->SrcY == p_snpoint->Y) && (p_ocpt->SrcZ == p_snpoint->Z))
+        {
+            game_screen_point_pool[specpt] = p_ocpt->Scr;
+            p_snpoint->Flags = p_ocpt->Flags;
+            continue;
+        }
 
-            p_snpoint->PointOffset = specpt + 0;
-            p_snpoint->Flags = sp1.Flags;
+        // Queue the point for transforming in batch
+        batch_dxc[batch_len] = p_snpoint->X + cor_dx;
+        batch_dyc[batch_len] = p_snpoint->Y + cor_dy - 8 * engn_yc;
+        batch_dzc[batch_len] = p_snpoint->Z + cor_dz;
+        batch_snpoint[batch_len] = snpoint;
+        batch_len++;
+        if (batch_len == OBJECT_POINTS_BATCH_LEN) {
+            object_points_batch_transform(p_ocobj, batch_len);
+            batch_len = 0;
         }
     }
+    if (batch_len > 0)
+        object_points_batch_transform(p_ocobj, batch_len);
 
     faces_num = point_object->NumbFaces4;
     face_beg = point_object->StartFace4;
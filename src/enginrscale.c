@@ -0,0 +1,149 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file enginrscale.c
+ *     Drawing the 3D engine view at lower resolution than the screen.
+ * @par Purpose:
+ *     Allows the engine to draw into a smaller buffer, which is then stretched
+ *     onto the screen before the HUD is drawn at full resolution.
+ * @par Comment:
+ *     The engine reads screen size, view window and zoom from globals, so
+ *     these are temporarily replaced while the 3D view is drawn. Mouse
+ *     position is scaled as well, as things under cursor are detected
+ *     during drawing.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "enginrscale.h"
+
+#include "bfmemory.h"
+#include "bfmemut.h"
+#include "bfscreen.h"
+#include "bfscrcopy.h"
+#include "poly.h"
+
+#include "engincam.h"
+#include "engintrns.h"
+#include "display.h"
+#include "swlog.h"
+/******************************************************************************/
+
+ubyte engine_render_scale = 100;
+
+static TbPixel *rscale_buf = NULL;
+static ulong rscale_buf_size = 0;
+static ushort rscale_width;
+static ushort rscale_height;
+static TbBool rscale_active = false;
+
+/** Screen state replaced for the time of drawing at lower resolution. */
+static struct ScreenBufBkp rscale_bkp;
+static ubyte *rscale_bkp_vec_screen;
+static long rscale_bkp_vec_screen_width;
+static long rscale_bkp_vec_window_width;
+static long rscale_bkp_vec_window_height;
+static ushort rscale_bkp_overall_scale;
+static long rscale_bkp_mouse_x;
+static long rscale_bkp_mouse_y;
+
+/******************************************************************************/
+
+void engine_render_scale_set(short percent)
+{
+    if (percent < ENGINE_RENDER_SCALE_MIN)
+        percent = ENGINE_RENDER_SCALE_MIN;
+    if (percent > 100)
+        percent = 100;
+    engine_render_scale = percent;
+}
+
+/** Prepares the lower resolution buffer; returns false if it should not be used.
+ */
+static TbBool engine_render_scaled_prepare(void)
+{
+    ulong size;
+
+    if (engine_render_scale >= 100)
+        return false;
+    rscale_width = lbDisplay.GraphicsScreenWidth * engine_render_scale / 100;
+    rscale_height = lbDisplay.GraphicsScreenHeight * engine_render_scale / 100;
+    // Keep even width, for vec window center to stay aligned with the screen
+    rscale_width &= ~1;
+    if ((rscale_width == 0) || (rscale_height < ENGINE_RENDER_MIN_HEIGHT))
+        return false;
+
+    size = rscale_width * rscale_height;
+    if (rscale_buf_size < size)
+    {
+        LbMemoryFree(rscale_buf);
+        rscale_buf = LbMemoryAlloc(size);
+        if (rscale_buf == NULL) {
+            LOGERR("Cannot allocate %lu bytes for engine render buffer", size);
+            rscale_buf_size = 0;
+            return false;
+        }
+        rscale_buf_size = size;
+        LOGSYNC("Engine render buffer %hux%hu", rscale_width, rscale_height);
+    }
+    return true;
+}
+
+void engine_render_scaled_begin(void)
+{
+    if (rscale_active)
+        return;
+    if (!engine_render_scaled_prepare())
+        return;
+
+    rscale_bkp_vec_screen = vec_screen;
+    rscale_bkp_vec_screen_width = vec_screen_width;
+    rscale_bkp_vec_window_width = vec_window_width;
+    rscale_bkp_vec_window_height = vec_window_height;
+    rscale_bkp_overall_scale = overall_scale;
+    rscale_bkp_mouse_x = lbDisplay.MMouseX;
+    rscale_bkp_mouse_y = lbDisplay.MMouseY;
+
+    lbDisplay.MMouseX = lbDisplay.MMouseX * rscale_width / lbDisplay.GraphicsScreenWidth;
+    lbDisplay.MMouseY = lbDisplay.MMouseY * rscale_height / lbDisplay.GraphicsScreenHeight;
+    overall_scale = overall_scale * rscale_width / lbDisplay.GraphicsScreenWidth;
+
+    screen_switch_to_custom_buffer(&rscale_bkp, rscale_buf, rscale_width, rscale_height);
+    LbMemorySet(rscale_buf, 0, rscale_width * rscale_height);
+    setup_vecs(rscale_buf, NULL, rscale_width, rscale_width, rscale_height);
+    engine_view_trig_update();
+    rscale_active = true;
+}
+
+void engine_render_scaled_end(void)
+{
+    if (!rscale_active)
+        return;
+    rscale_active = false;
+
+    screen_load_backup_buffer(&rscale_bkp);
+    setup_vecs(rscale_bkp_vec_screen, NULL, rscale_bkp_vec_screen_width,
+      rscale_bkp_vec_window_width, rscale_bkp_vec_window_height);
+    overall_scale = rscale_bkp_overall_scale;
+    lbDisplay.MMouseX = rscale_bkp_mouse_x;
+    lbDisplay.MMouseY = rscale_bkp_mouse_y;
+    engine_view_trig_update();
+
+    LbScreenCopyScaled(rscale_buf, rscale_width, rscale_height, rscale_width,
+      lbDisplay.WScreen, lbDisplay.GraphicsScreenWidth,
+      lbDisplay.GraphicsScreenHeight, lbDisplay.GraphicsScreenWidth);
+}
+
+void engine_render_scale_reset(void)
+{
+    LbMemoryFree(rscale_buf);
+    rscale_buf = NULL;
+    rscale_buf_size = 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,69 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file enginrscale.h
+ *     Header file for enginrscale.c.
+ * @par Purpose:
+ *     Drawing the 3D engine view at lower resolution than the screen.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef ENGINRSCALE_H
+#define ENGINRSCALE_H
+
+#include "bftypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Lowest allowed engine render scale, in percent of screen resolution.
+ */
+#define ENGINE_RENDER_SCALE_MIN 50
+
+/** Lowest height of the engine render buffer.
+ * Below that, the engine would switch to its low resolution specific code.
+ */
+#define ENGINE_RENDER_MIN_HEIGHT 400
+
+/** Resolution of the 3D engine view, in percent of screen resolution.
+ */
+extern ubyte engine_render_scale;
+
+/******************************************************************************/
+
+/** Sets resolution of the 3D engine view, in percent of screen resolution.
+ */
+void engine_render_scale_set(short percent);
+
+/** Switches drawing to the lower resolution engine buffer.
+ *
+ * Screen buffer, engine view window, zoom and mouse position are replaced
+ * with ones matching the lower resolution, until engine_render_scaled_end().
+ * Does nothing if the render scale is 100%.
+ */
+void engine_render_scaled_begin(void);
+
+/** Restores the screen state, and stretches the engine buffer onto screen.
+ * To be called after the 3D view is drawn, but before the HUD.
+ */
+void engine_render_scaled_end(void);
+
+/** Frees memory used for the lower resolution engine buffer.
+ */
+void engine_render_scale_reset(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -17,6 +17,7 @@
  */
 /******************************************************************************/
 #include "bfconfig.h"
+#include "bfasync.h"
 #include "bfcircle.h"
 #include "bfdata.h"
 #include "bfendian.h"
@@ -83,6 +84,7 @@
 #include "enginlights.h"
 #include "enginpriobjs.h"
 #include "enginpritxtr.h"
+#include "enginrscale.h"
 #include "enginsngobjs.h"
 #include "enginsngtxtr.h"
 #include "enginpeff.h"
@@ -90,8 +92,10 @@
 #include "engintext.h"
 #include "engintrns.h"
 #include "enginzoom.h"
+#include "game_bench.h"
 #include "game_data.h"
 #include "game_options.h"
+#include "game_prof.h"
 #include "game_save.h"
 #include "game_sprts.h"
 #include "guiboxes.h"
@@ -153,6 +157,7 @@
 #include "scandraw.h"
 #include "thing.h"
 #include "thing_expld.h"
+#include "thing_interp.h"
 #include "thing_search.h"
 #include "thing_onface.h"
 #include "thing_ovmous.h"
@@ -1646,7 +1651,7 @@ void engine_draw_things(int pos_beg_x, int pos_beg_z, int rend_beg_x, int rend_b
                         struct Thing *p_thing;
                         p_thing = &things[thing];
                         if ((p_thing->Type == TT_BUILDING)
-                         && (p_thing->U.UObject.DrawTurn != gameturn)) {
+                         && (p_thing->U.UObject.DrawTurn != render_frame)) {
                             draw_thing_object(p_thing);
                         }
                     }
@@ -1684,7 +1689,7 @@ void engine_draw_things(int pos_beg_x, int pos_beg_z, int rend_beg_x, int rend_b
                         struct Thing *p_thing;
                         p_thing = &things[thing];
                         if ((p_thing->Type == TT_BUILDING)
-                          && (p_thing->U.UObject.DrawTurn != gameturn)
+                          && (p_thing->U.UObject.DrawTurn != render_frame)
                           && (p_thing->U.UObject.BHeight > 1400)) {
                             draw_thing_object(p_thing);
                         }
@@ -1698,7 +1703,7 @@ void engine_draw_things(int pos_beg_x, int pos_beg_z, int rend_beg_x, int rend_b
                         struct Thing *p_thing;
                         p_thing = &things[thing];
                         if ( p_thing->Type == TT_BUILDING
-                          && (p_thing->U.UObject.DrawTurn != gameturn)
+                          && (p_thing->U.UObject.DrawTurn != render_frame)
                           && (p_thing->U.UObject.BHeight > 1400)) {
                             thing = draw_thing_object(p_thing);
                             continue;
@@ -1831,42 +1836,10 @@ void screen_sorted_sprite_persn_render_callback(ushort sspr)
     }
 }
 
-void process_engine_unk3(void)
+/** Fills the drawlist with the scene visible from current camera position.
+ */
+static void engine_fill_scene(void)
 {
-    PlayerInfo *p_locplayer;
-
-    get_engine_inputs();
-
-    reset_drawlist();
-    ingame.NextRocket = 0;
-    screen_position_face_render_cb = screen_position_face_render_callback;
-    screen_sorted_sprite_statc_render_cb = screen_sorted_sprite_statc_render_callback;
-    screen_sorted_sprite_persn_render_cb = screen_sorted_sprite_persn_render_callback;
-    player_target_clear(local_player_no);
-    mech_unkn_dw_1DC880 = mech_unkn_tile_x1;
-    mech_unkn_dw_1DC884 = mech_unkn_tile_y1;
-    mech_unkn_dw_1DC888 = mech_unkn_tile_x2;
-    mech_unkn_dw_1DC88C = mech_unkn_tile_y2;
-    mech_unkn_dw_1DC890 = mech_unkn_tile_x3;
-    mech_unkn_dw_1DC894 = mech_unkn_tile_y3;
-
-    process_map_craters();
-
-    if (((ingame.Flags & GamF_BillboardBAT) == 0) &&
-      ((ingame.Flags & GamF_BillboardMovies) != 0))
-    {
-        dword_176CBC += fifties_per_gameturn;
-        if (dword_176CBC > 80)
-        {
-            dword_176CBC = 0;
-            if (!in_network_game && ((ingame.Flags & GamF_Unkn00040000) != 0))
-            {
-                ingame.Flags &= ~GamF_Unkn00040000;
-                xdo_next_frame(AniSl_BILLBOARD);
-            }
-        }
-    }
-
     int rend_beg_x, rend_beg_z;
     int pos_beg_x, pos_beg_z;
     int tlcount_x, tlcount_z;
@@ -1875,7 +1848,9 @@ void process_engine_unk3(void)
 
     if ((ingame.Flags & GamF_RenderScene) != 0)
     {
+        frame_prof_begin(FPrPh_DRAWLIST_FILL);
         engine_draw_things(pos_beg_x, pos_beg_z, rend_beg_x, rend_beg_z, tlcount_x, tlcount_z);
+        frame_prof_end(FPrPh_DRAWLIST_FILL);
     }
 
     if ((ingame.Flags & GamF_RenderScene) != 0)
@@ -1893,7 +1868,14 @@ void process_engine_unk3(void)
     {
         clear_super_quick_lights();
     }
-    process_explode();
+}
+
+/** Draws the filled drawlist, and the HUD over it.
+ */
+static void engine_draw_scene(void)
+{
+    PlayerInfo *p_locplayer;
+
     assert(vec_tmap[1] != NULL);
     vec_map = vec_tmap[1];
     face_transp_tinted_surface_col = deep_radar_surface_col;
@@ -1904,7 +1886,10 @@ void process_engine_unk3(void)
     {
         draw_explode();
         draw_screen();
+        engine_render_scaled_end();
+        frame_prof_begin(FPrPh_HUD);
         draw_hud(p_locplayer->DirectControl[0]);
+        frame_prof_end(FPrPh_HUD);
         if (in_network_game)
             draw_engine_net_text();
         if (debug_hud_collision)
@@ -1912,12 +1897,117 @@ void process_engine_unk3(void)
     }
     else
     {
+        engine_render_scaled_end();
+        frame_prof_begin(FPrPh_HUD);
         draw_hud(p_locplayer->DirectControl[0]);
+        frame_prof_end(FPrPh_HUD);
         reset_drawlist();
         ingame.NextRocket = 0;
     }
 }
 
+void process_engine_unk3(void)
+{
+    get_engine_inputs();
+
+    render_pools_frame_end();
+    reset_drawlist();
+    ingame.NextRocket = 0;
+    screen_position_face_render_cb = screen_position_face_render_callback;
+    screen_sorted_sprite_statc_render_cb = screen_sorted_sprite_statc_render_callback;
+    screen_sorted_sprite_persn_render_cb = screen_sorted_sprite_persn_render_callback;
+    player_target_clear(local_player_no);
+    mech_unkn_dw_1DC880 = mech_unkn_tile_x1;
+    mech_unkn_dw_1DC884 = mech_unkn_tile_y1;
+    mech_unkn_dw_1DC888 = mech_unkn_tile_x2;
+    mech_unkn_dw_1DC88C = mech_unkn_tile_y2;
+    mech_unkn_dw_1DC890 = mech_unkn_tile_x3;
+    mech_unkn_dw_1DC894 = mech_unkn_tile_y3;
+
+    process_map_craters();
+
+    if (((ingame.Flags & GamF_BillboardBAT) == 0) &&
+      ((ingame.Flags & GamF_BillboardMovies) != 0))
+    {
+        dword_176CBC += fifties_per_gameturn;
+        if (dword_176CBC > 80)
+        {
+            dword_176CBC = 0;
+            if (!in_network_game && ((ingame.Flags & GamF_Unkn00040000) != 0))
+            {
+                ingame.Flags &= ~GamF_Unkn00040000;
+                xdo_next_frame(AniSl_BILLBOARD);
+            }
+        }
+    }
+
+    quick_lights_shade_cache_update();
+    engine_render_scaled_begin();
+    engine_fill_scene();
+    process_explode();
+    engine_draw_scene();
+}
+
+static void screen_position_face_render_none(
+  struct PolyPoint *p_pt1,
+  struct PolyPoint *p_pt2,
+  struct PolyPoint *p_pt3,
+  ushort face, ubyte type)
+{
+}
+
+static void screen_sorted_sprite_render_none(ushort sspr)
+{
+}
+
+/** Draws an additional engine frame between game turns.
+ *
+ * Things and camera are placed at positions interpolated between the
+ * previous and current turn. Nothing which affects the game state is
+ * processed here - no inputs, no animations, no mouse picking. The number
+ * of such frames depends on wall clock, so anything the drawing changes
+ * which the game turns could see - the random seed and local player
+ * target - is restored afterwards.
+ */
+static void show_game_engine_interp(ushort fraction)
+{
+    PlayerInfo *p_locplayer;
+    ulong prev_seed;
+    short prev_target, prev_target_type, prev_field_102;
+
+    p_locplayer = &players[local_player_no];
+    prev_seed = lbSeed;
+    prev_target = p_locplayer->Target;
+    prev_target_type = p_locplayer->TargetType;
+    prev_field_102 = p_locplayer->field_102;
+
+    render_frame++;
+    thing_interp_apply(fraction);
+    engine_view_trig_update();
+
+    render_pools_frame_end();
+    reset_drawlist();
+    ingame.NextRocket = 0;
+    screen_position_face_render_cb = screen_position_face_render_none;
+    screen_sorted_sprite_statc_render_cb = screen_sorted_sprite_render_none;
+    screen_sorted_sprite_persn_render_cb = screen_sorted_sprite_render_none;
+    quick_lights_shade_cache_update();
+    engine_render_scaled_begin();
+    engine_fill_scene();
+    engine_draw_scene();
+
+    screen_position_face_render_cb = screen_position_face_render_callback;
+    screen_sorted_sprite_statc_render_cb = screen_sorted_sprite_statc_render_callback;
+    screen_sorted_sprite_persn_render_cb = screen_sorted_sprite_persn_render_callback;
+    thing_interp_restore();
+    engine_view_trig_update();
+
+    p_locplayer->Target = prev_target;
+    p_locplayer->TargetType = prev_target_type;
+    p_locplayer->field_102 = prev_field_102;
+    lbSeed = prev_seed;
+}
+
 void process_sound_heap(void)
 {
     asm volatile ("call ASM_process_sound_heap\n"
@@ -2321,6 +2411,11 @@ void init_syndwars(void)
     audOpts.AbleFlags = 3;
     audOpts.SoundType = 1622;
     audOpts.MaxSamples = 10;
+    if (bench_replay_is_active()) {
+        // Headless benchmark - disable music, sound and CD audio
+        audOpts.AbleFlags = 0;
+        audOpts.InitRedbookAudio = 0;
+    }
     InitAudio(&audOpts);
 
     if (!GetCDAble())
@@ -3691,9 +3786,11 @@ void show_game_engine(void)
     process_view_inputs(dcthing);// inlined call gengine_ctrl
 
     compute_scanner_zoom();
+    render_frame++;
     process_engine_unk1();
     process_engine_unk2();
     process_engine_unk3();
+    thing_interp_camera_store();
 }
 
 void gproc3_unknsub2(void)
@@ -6145,6 +6242,10 @@ void show_load_and_prep_mission(void)
         ingame.DisplayMode = DpM_UNKN_1;
     }
 
+    // Start reading the map in background, while the screen is being prepared
+    if (start_into_mission)
+        prefetch_map_mad(mission_list[ingame.CurrentMission].MapNo);
+
     reload_background_flag = 1;
     // Setup screen, palette and colour tables
     debug_trace_place(13);
@@ -6631,7 +6732,9 @@ void show_game_screen(void)
     if (skip_redraw_this_turn())
         return;
 
+    frame_prof_begin(FPrPh_ENGINE);
     show_game_engine();
+    frame_prof_end(FPrPh_ENGINE);
 
     if ((ingame.Flags & GamF_Unkn0800) != 0)
         gproc3_unknsub2();
@@ -6869,8 +6972,11 @@ void load_packet(void)
     game_graphics_inputs();
     if (PacketRecord_IsPlayback()) // packet replay controls
     {
-        if (!in_network_game)
-            PacketRecord_Read(p_pckt, p_locplayer->DoubleMode);
+        if (!in_network_game) {
+            TbResult ret;
+            ret = PacketRecord_Read(p_pckt, p_locplayer->DoubleMode);
+            bench_replay_packet_read(ret);
+        }
         input_packet_playback();
         ingame.MissionStatus = test_missions(0);
         return;
@@ -7051,11 +7157,98 @@ void game_process_orbital_station_explode(void)
     }
 }
 
+/** Game loop variant for headless replay benchmark.
+ *
+ * Does the same simulation steps as game_process(), but skips drawing,
+ * sound and waiting for the next turn. Note that some state changes
+ * caused by drawing (ie. things visible on screen) are not replicated,
+ * so packet files recorded with different view may lose sync.
+ */
+static void game_process_bench_replay(void)
+{
+    while ( !exit_game )
+    {
+        bench_replay_turn_begin();
+        navi2_unkn_counter -= 2;
+        if (navi2_unkn_counter < 0)
+            navi2_unkn_counter = 0;
+        if (navi2_unkn_counter > navi2_unkn_counter_max)
+            navi2_unkn_counter_max = navi2_unkn_counter;
+        update_tick_time();
+        load_packet();
+        if (bench_replay.Finished)
+            break;
+        bench_replay_input_done();
+        if ((ingame.DisplayMode == DpM_ENGINEPLY)
+          || (ingame.DisplayMode == DpM_UNKN_1)
+          || (ingame.DisplayMode == DpM_UNKN_3B))
+            process_things();
+        if (ingame.DisplayMode != DpM_PURPLEMNU) {
+            frame_prof_begin(FPrPh_PACKETS);
+            process_packets();
+            frame_prof_end(FPrPh_PACKETS);
+        }
+        // Keep the OS informed that we are alive, but not every turn
+        if ((gameturn & 0x3F) == 0)
+            game_hacky_update();
+
+        game_process_orbital_station_explode();
+        gameturn++;
+        render_anim_turn = gameturn;
+        scene_post_effect_prepare();
+        bench_replay_turn_end();
+        frame_prof_turn_end(gameturn);
+    }
+    bench_replay_report();
+    render_pools_report();
+    PacketRecord_Close();
+    frame_prof_csv_close();
+}
+
+/** Returns whether interpolated frames are to be drawn after the current turn.
+ */
+static TbBool game_interp_frames_enabled(void)
+{
+    if (ingame.DisplayMode != DpM_ENGINEPLY)
+        return false;
+    // The map overlay is not redrawn within interpolated frames
+    if ((ingame.Flags & GamF_Unkn0800) != 0)
+        return false;
+    // Keep network games free of anything which depends on local frame rate
+    if (in_network_game)
+        return false;
+    return render_interp_enabled();
+}
+
+/** Draws interpolated frames until it is time for the next game turn.
+ */
+static void game_draw_interp_frames(void)
+{
+    while (!exit_game && wait_next_render_frame())
+    {
+        game_hacky_update();
+        frame_prof_begin(FPrPh_ENGINE);
+        show_game_engine_interp(gameturn_elapsed_fraction());
+        frame_prof_end(FPrPh_ENGINE);
+        frame_prof_draw_overlay();
+        frame_prof_begin(FPrPh_SCREEN_SWAP);
+        LbScreenSwapClear(0);
+        frame_prof_end(FPrPh_SCREEN_SWAP);
+    }
+}
+
 void game_process(void)
 {
+    TbBool interp;
+
     debug_multicolor_sprite(193);
     LOGDBG("WSCREEN 0x%p", (void *)lbDisplay.WScreen);
 
+    if (bench_replay_is_active()) {
+        game_process_bench_replay();
+        return;
+    }
+
     while ( !exit_game )
     {
         process_sound_heap();
@@ -7078,25 +7271,48 @@ void game_process(void)
           ((ingame.Flags & GamF_ThermalView) != 0) )
             LbPaletteSet(display_palette);
         active_flags_general_unkn01 = ingame.Flags;
+        interp = game_interp_frames_enabled() && !skip_redraw_this_turn();
+        if (interp)
+            thing_interp_snapshot();
         if ((ingame.DisplayMode == DpM_ENGINEPLY)
           || (ingame.DisplayMode == DpM_UNKN_1)
           || (ingame.DisplayMode == DpM_UNKN_3B))
             process_things();
         if (debug_hud_things)
             things_debug_hud();
-        if (ingame.DisplayMode != DpM_PURPLEMNU)
+        if (ingame.DisplayMode == DpM_ENGINEPLY)
+            frame_prof_draw_overlay();
+        if (ingame.DisplayMode != DpM_PURPLEMNU) {
+            frame_prof_begin(FPrPh_PACKETS);
             process_packets();
+            frame_prof_end(FPrPh_PACKETS);
+        }
         joy_input();
 
         if (ingame.DisplayMode == DpM_PURPLEMNU)
         {
             game_update();
+            frame_prof_begin(FPrPh_SCREEN_SWAP);
             swap_wscreen();
+            frame_prof_end(FPrPh_SCREEN_SWAP);
+        }
+        else if (interp)
+        {
+            // Show the turn frame now, then fill the rest of turn time
+            // with frames moving towards the state we have just computed
+            game_hacky_update();
+            frame_prof_begin(FPrPh_SCREEN_SWAP);
+            LbScreenSwapClear(0);
+            frame_prof_end(FPrPh_SCREEN_SWAP);
+            game_draw_interp_frames();
+            game_update();
         }
         else if (!skip_redraw_this_turn())
         {
             game_update();
+            frame_prof_begin(FPrPh_SCREEN_SWAP);
             LbScreenSwapClear(0);
+            frame_prof_end(FPrPh_SCREEN_SWAP);
         }
 
         update_unkn_changing_colors();
@@ -7104,8 +7320,11 @@ void game_process(void)
         gameturn++;
         render_anim_turn = gameturn;
         scene_post_effect_prepare();
+        frame_prof_turn_end(gameturn);
     }
+    render_pools_report();
     PacketRecord_Close();
+    frame_prof_csv_close();
     LbPaletteFade(NULL, 0x10u, 1);
 }
 
@@ -7113,7 +7332,7 @@ void game_quit(void)
 {
     host_reset();
     LbBaseReset();
-    exit(0);
+    exit(bench_replay_exit_status());
 }
 
 static void game_update_full(bool wait)
@@ -7152,6 +7371,8 @@ void host_reset(void)
     setup_heaps(SHSC_ResetGameSnd, language_3str);
     FreeAudio();
     engine_reset();
+    wadfile_archives_close_all();
+    LbAsyncFileShutdown();
     reset_multicolor_sprites();
     reset_mouse_pointers();
     LbMouseReset();
@@ -7164,6 +7385,8 @@ void game_reset(void)
 {
     host_reset();
     free_texturemaps();
+    quick_lights_shade_cache_free();
+    engine_render_scale_reset();
     LbDataFreeAll(missionspr_load_files);
 }
 
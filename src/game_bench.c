@@ -0,0 +1,277 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file game_bench.c
+ *     Headless benchmark of game simulation.
+ * @par Purpose:
+ *     Replays packet record file as fast as possible, without drawing,
+ *     sound or frame rate limit, and measures the simulation speed.
+ * @par Comment:
+ *     The random seed stored within packet file for each turn is compared,
+ *     but only for information - drawing the game also consumes random
+ *     numbers, so recordings made with drawing never match a headless
+ *     replay. To verify determinism, compare the world checksum reported
+ *     by two headless runs; the expected checksum can be given, to make
+ *     the benchmark fail if the simulation went differently.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "game_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bfmemut.h"
+#include "bftime.h"
+#include "bfutility.h"
+
+#include "game.h"
+#include "game_options.h"
+#include "game_speed.h"
+#include "packet.h"
+#include "thing.h"
+#include "swlog.h"
+/******************************************************************************/
+
+struct BenchReplay bench_replay = {0};
+
+/** Duration of each game turn, in microseconds. */
+static u32 bench_turn_samples[BENCH_TURN_SAMPLES_MAX];
+
+/** Expected world checksum at end of the replay; kept outside of
+ * bench_replay, as it may be set before the benchmark setup.
+ */
+static TbBool bench_expect_checksum_set = false;
+static u32 bench_expect_checksum = 0;
+
+/******************************************************************************/
+
+void bench_replay_setup(ushort campgn, ushort missi, ushort recno)
+{
+    LbMemorySet(&bench_replay, 0, sizeof(bench_replay));
+    bench_replay.Active = true;
+    bench_replay.Campaign = campgn;
+    bench_replay.Mission = missi;
+    bench_replay.RecordNo = recno;
+    bench_replay.LastReadResult = Lb_SUCCESS;
+
+    // Start the mission directly, same as '-m' and '-p' options do
+    is_single_game = 1;
+    background_type = campgn;
+    ingame.GameMode = GamM_Unkn2;
+    ingame.Flags |= GamF_Unkn0008 | GamF_SkipIntro;
+    ingame.CurrentMission = missi;
+    pktrec_mode = PktR_PLAYBACK;
+    packet_rec_no = recno;
+}
+
+void bench_replay_expect_checksum(u32 csum)
+{
+    bench_expect_checksum = csum;
+    bench_expect_checksum_set = true;
+}
+
+TbBool bench_replay_is_active(void)
+{
+    return bench_replay.Active;
+}
+
+void bench_replay_packet_read(TbResult ret)
+{
+    if (!bench_replay.Active)
+        return;
+    bench_replay.LastReadResult = ret;
+    if (ret != Lb_SUCCESS) {
+        bench_replay.Finished = true;
+        exit_game = true;
+    }
+}
+
+void bench_replay_input_done(void)
+{
+    if (!bench_replay.Active || bench_replay.Finished)
+        return;
+    // Only lower bits of the seed are stored in packet file
+    if (packet_rec_seed == (ushort)lbSeed)
+        return;
+    if (bench_replay.SeedMismatches == 0) {
+        bench_replay.FirstMismatchTurn = gameturn;
+        LOGDBG("Replay seed differs at turn %lu, recorded 0x%04hx, got 0x%04hx",
+          (ulong)gameturn, packet_rec_seed, (ushort)lbSeed);
+    }
+    bench_replay.SeedMismatches++;
+}
+
+void bench_replay_turn_begin(void)
+{
+    bench_replay.TurnStartTime = LbTimerClockMicro();
+    if (bench_replay.Turns == 0)
+        bench_replay.StartTime = bench_replay.TurnStartTime;
+}
+
+void bench_replay_turn_end(void)
+{
+    TbClockUSec delta;
+
+    delta = LbTimerClockMicro() - bench_replay.TurnStartTime;
+    if (bench_replay.Turns < BENCH_TURN_SAMPLES_MAX)
+        bench_turn_samples[bench_replay.Turns] = delta;
+    bench_replay.TotalTime += delta;
+    bench_replay.Turns++;
+}
+
+static u32 checksum_add(u32 csum, s32 val)
+{
+    // FNV-1a, processing the value as 4 bytes
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        csum ^= (val >> (8 * i)) & 0xFF;
+        csum *= 16777619;
+    }
+    return csum;
+}
+
+u32 bench_replay_world_checksum(void)
+{
+    u32 csum;
+    ThingIdx thing;
+    int remain;
+
+    csum = 2166136261u;
+    csum = checksum_add(csum, gameturn);
+    csum = checksum_add(csum, lbSeed);
+
+    remain = things_used;
+    for (thing = things_used_head; thing > 0; thing = things[thing].LinkChild)
+    {
+        struct Thing *p_thing;
+
+        if (--remain == -1)
+            break;
+        p_thing = &things[thing];
+        csum = checksum_add(csum, thing);
+        csum = checksum_add(csum, (p_thing->Type << 8) | p_thing->SubType);
+        csum = checksum_add(csum, (p_thing->State << 8) | p_thing->SubState);
+        csum = checksum_add(csum, p_thing->Flag);
+        csum = checksum_add(csum, p_thing->Flag2);
+        csum = checksum_add(csum, p_thing->X);
+        csum = checksum_add(csum, p_thing->Y);
+        csum = checksum_add(csum, p_thing->Z);
+        csum = checksum_add(csum, p_thing->VX);
+        csum = checksum_add(csum, p_thing->VY);
+        csum = checksum_add(csum, p_thing->VZ);
+        csum = checksum_add(csum, p_thing->Health);
+        csum = checksum_add(csum, p_thing->Owner);
+    }
+
+    remain = sthings_used;
+    for (thing = sthings_used_head; thing < 0; thing = sthings[thing].LinkChild)
+    {
+        struct SimpleThing *p_sthing;
+
+        if (--remain == -1)
+            break;
+        p_sthing = &sthings[thing];
+        csum = checksum_add(csum, thing);
+        csum = checksum_add(csum, (p_sthing->Type << 8) | p_sthing->SubType);
+        csum = checksum_add(csum, p_sthing->State);
+        csum = checksum_add(csum, p_sthing->X);
+        csum = checksum_add(csum, p_sthing->Y);
+        csum = checksum_add(csum, p_sthing->Z);
+        csum = checksum_add(csum, p_sthing->Timer1);
+    }
+    return csum;
+}
+
+static int turn_sample_compare(const void *p1, const void *p2)
+{
+    u32 v1 = *(const u32 *)p1;
+    u32 v2 = *(const u32 *)p2;
+
+    if (v1 < v2)
+        return -1;
+    return (v1 > v2);
+}
+
+static u32 turn_sample_percentile(ulong nsamples, int permille)
+{
+    ulong i;
+
+    if (nsamples == 0)
+        return 0;
+    i = (nsamples * permille) / 1000;
+    if (i >= nsamples)
+        i = nsamples - 1;
+    return bench_turn_samples[i];
+}
+
+void bench_replay_report(void)
+{
+    ulong nsamples;
+    double tps;
+    u32 csum;
+
+    if (!bench_replay.Active)
+        return;
+
+    nsamples = bench_replay.Turns;
+    if (nsamples > BENCH_TURN_SAMPLES_MAX)
+        nsamples = BENCH_TURN_SAMPLES_MAX;
+    qsort(bench_turn_samples, nsamples, sizeof(bench_turn_samples[0]),
+      turn_sample_compare);
+
+    if (bench_replay.TotalTime > 0)
+        tps = (double)bench_replay.Turns * 1000000.0 / bench_replay.TotalTime;
+    else
+        tps = 0.0;
+    csum = bench_replay_world_checksum();
+    bench_replay.FinalChecksum = csum;
+
+    printf("Bench replay: campaign %hu mission %hu record %hu\n",
+      bench_replay.Campaign, bench_replay.Mission, bench_replay.RecordNo);
+    printf("  turns: %lu, simulation time: %lld us, %.1f turns/s\n",
+      bench_replay.Turns, bench_replay.TotalTime, tps);
+    printf("  turn time us: p50 %lu, p90 %lu, p99 %lu, max %lu\n",
+      (ulong)turn_sample_percentile(nsamples, 500),
+      (ulong)turn_sample_percentile(nsamples, 900),
+      (ulong)turn_sample_percentile(nsamples, 990),
+      (ulong)turn_sample_percentile(nsamples, 1000));
+    // Not a desync - the recording may have been made with drawing enabled
+    if (bench_replay.SeedMismatches != 0)
+        printf("  seed differs from recording: %lu turns, first at turn %lu\n",
+          bench_replay.SeedMismatches, (ulong)bench_replay.FirstMismatchTurn);
+    else
+        printf("  seed differs from recording: none\n");
+    printf("  world checksum: 0x%08lx\n", (ulong)csum);
+    if (bench_expect_checksum_set) {
+        if (csum == bench_expect_checksum)
+            printf("  expected checksum: matches\n");
+        else
+            printf("  expected checksum: 0x%08lx, DESYNC\n",
+              (ulong)bench_expect_checksum);
+    }
+
+    LOGSYNC_F("Bench replay turns %lu, %.1f turns/s, seed mismatches %lu, checksum 0x%08lx",
+      bench_replay.Turns, tps, bench_replay.SeedMismatches, (ulong)csum);
+}
+
+int bench_replay_exit_status(void)
+{
+    if (!bench_replay.Active)
+        return 0;
+    // No turns means the packet file could not be read at all
+    if (bench_replay.Turns == 0)
+        return 1;
+    if (bench_expect_checksum_set &&
+      (bench_replay.FinalChecksum != bench_expect_checksum))
+        return 2;
+    return 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,117 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file game_bench.h
+ *     Header file for game_bench.c.
+ * @par Purpose:
+ *     Headless benchmark of game simulation, driven by packet record files.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef GAME_BENCH_H
+#define GAME_BENCH_H
+
+#include "bftypes.h"
+#include "game_bstype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Amount of game turns for which individual time is stored.
+ * Turns above that limit are still simulated and counted in totals,
+ * but do not contribute to latency percentiles.
+ */
+#define BENCH_TURN_SAMPLES_MAX 65536
+
+struct BenchReplay {
+    /** Whether the replay benchmark mode is enabled. */
+    TbBool Active;
+    /** Set when the packet file ended and no more turns can be replayed. */
+    TbBool Finished;
+    ushort Campaign;
+    ushort Mission;
+    ushort RecordNo;
+    /** Amount of turns simulated since the benchmark started. */
+    ulong Turns;
+    /** Amount of turns where the seed stored in packet file did not match.
+     * Drawing consumes random numbers, so this is only informative. */
+    ulong SeedMismatches;
+    /** Game turn at which the first seed mismatch was detected. */
+    GameTurn FirstMismatchTurn;
+    /** Result of the last packet file read. */
+    TbResult LastReadResult;
+    /** World checksum computed when the replay ended. */
+    u32 FinalChecksum;
+    TbClockUSec StartTime;
+    TbClockUSec TurnStartTime;
+    TbClockUSec TotalTime;
+};
+
+/******************************************************************************/
+extern struct BenchReplay bench_replay;
+/******************************************************************************/
+
+/** Enables the headless replay benchmark on given mission and packet file.
+ *
+ * Needs to be called before game setup; alters the game options so that
+ * the mission is started directly, with replay from the packet file.
+ */
+void bench_replay_setup(ushort campgn, ushort missi, ushort recno);
+
+/** Sets world checksum expected at end of the replay.
+ *
+ * The checksum should come from an earlier headless run of the same replay;
+ * if it does not match, the simulation is no longer deterministic.
+ */
+void bench_replay_expect_checksum(u32 csum);
+
+/** Returns whether the headless replay benchmark mode is enabled.
+ */
+TbBool bench_replay_is_active(void);
+
+/** Informs the benchmark about result of reading one turn of packets.
+ */
+void bench_replay_packet_read(TbResult ret);
+
+/** Compares the seed stored in packet file with the current one.
+ * To be called after all the packet input for a turn was processed.
+ * Mismatches are only counted; they are expected for recordings which
+ * were made with the game being drawn.
+ */
+void bench_replay_input_done(void);
+
+void bench_replay_turn_begin(void);
+void bench_replay_turn_end(void);
+
+/** Computes a checksum of the simulated world state.
+ *
+ * Only fields which do not depend on memory layout are included,
+ * so the value can be compared between runs and builds.
+ */
+u32 bench_replay_world_checksum(void);
+
+/** Prints summary of the benchmark run to standard output and log.
+ */
+void bench_replay_report(void);
+
+/** Gives process exit status representing the benchmark result.
+ * Returns 0 if the benchmark is disabled or passed, 1 if the packet file
+ * gave no turns to replay, 2 if world checksum differs from the expected one.
+ */
+int bench_replay_exit_status(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
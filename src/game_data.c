@@ -22,6 +22,7 @@
 #include "bffile.h"
 #include "bfdir.h"
 #include "bffnuniq.h"
+#include "bfmemory.h"
 #include "bfmemut.h"
 #include "bfstrut.h"
 
@@ -37,6 +38,7 @@
 #include "enginsngobjs.h"
 #include "enginsngtxtr.h"
 #include "engintxtrmap.h"
+#include "enginzoom.h"
 #include "bigmap.h"
 #include "game_options.h"
 #include "game.h"
@@ -104,6 +106,42 @@ MemSystem mem_game[] = {
   { NULL,				NULL,							0u, 0, 0, 0, 0 }
 };
 
+/** Drawlist pools which may grow while the game is running.
+ *
+ * The pools start within mem_game[] buffers; when a pool needs to grow,
+ * it is moved to a separately allocated buffer. Items are referenced by
+ * index, so moving the pool between frames does not invalidate anything.
+ */
+struct RenderPool {
+    const char *Name;
+    void **BufferPtr;
+    s32 *Limit;
+    /** Max amount of items which can be referenced by index in this pool. */
+    s32 IndexLimit;
+    /** Amount of items allocated at start, for render area of reference size. */
+    s32 BaseN;
+    /** Highest amount of items used in one frame. */
+    s32 HighWater;
+    /** Amount of frames in which the pool was full or nearly full. */
+    ulong FullFrames;
+    /** Buffer allocated after the pool grew out of its mem_game[] area. */
+    void *GrownBuf;
+};
+
+static struct RenderPool render_pools[] = {
+  { "screen_point_pool",(void **)&game_screen_point_pool,&screen_points_limit,0xFFFF, 0, 0, 0, NULL },
+  { "draw_list",		(void **)&game_draw_list,		&draw_items_limit,	0xFFFF, 0, 0, 0, NULL },
+  { "sort_sprites",		(void **)&game_sort_sprites,	&sort_sprites_limit,0xFFFF, 0, 0, 0, NULL },
+  { "sort_lines",		(void **)&game_sort_lines,		&sort_lines_limit,	0xFFFF, 0, 0, 0, NULL },
+  { "floor_tiles",		(void **)&game_floor_tiles,		&floor_tiles_limit,	0x7FFF, 0, 0, 0, NULL },
+  { NULL,				NULL,							NULL,				0, 0, 0, 0, NULL },
+};
+
+/** Render area side for which the mem_game[] sizes of drawlist pools were
+ * chosen; larger areas get their pools scaled up.
+ */
+#define RENDER_POOLS_BASE_AREA 30
+
 PathInfo game_dirs[] = {
   {"data",		1},
   {"qdata",		0},
@@ -602,6 +640,103 @@ TbResult propagate_memory_sizes(void)
     return ret;
 }
 
+/** Moves the pool to a bigger buffer, keeping its content.
+ */
+static TbBool render_pool_grow(struct RenderPool *p_pool, s32 new_n)
+{
+    MemSystem *ment;
+    void *buf;
+    int i;
+
+    i = get_memory_ptr_index(p_pool->BufferPtr);
+    if (i < 0)
+        return false;
+    ment = &mem_game[i];
+    if (new_n > p_pool->IndexLimit)
+        new_n = p_pool->IndexLimit;
+    if (new_n <= ment->N)
+        return false;
+
+    buf = LbMemoryAlloc(new_n * (ulong)ment->ESize);
+    if (buf == NULL) {
+        LOGWARN("Cannot grow %s pool to %ld items", p_pool->Name, (long)new_n);
+        // Prevent further attempts
+        p_pool->IndexLimit = ment->N;
+        return false;
+    }
+    LbMemoryCopy(buf, *p_pool->BufferPtr, ment->N * (ulong)ment->ESize);
+    LbMemorySet((ubyte *)buf + ment->N * (ulong)ment->ESize, 0,
+      (new_n - ment->N) * (ulong)ment->ESize);
+    LOGSYNC("Grown %s pool from %ld to %ld items", p_pool->Name,
+      (long)ment->N, (long)new_n);
+
+    *p_pool->BufferPtr = buf;
+    LbMemoryFree(p_pool->GrownBuf);
+    p_pool->GrownBuf = buf;
+    ment->N = new_n;
+    *p_pool->Limit = new_n;
+    return true;
+}
+
+void render_pools_frame_end(void)
+{
+    struct RenderPool *p_pool;
+    s32 used[5];
+    s32 view_area, base_area;
+    int i;
+
+    used[0] = next_screen_point;
+    used[1] = next_draw_item;
+    used[2] = next_sort_sprite;
+    used[3] = next_sort_line;
+    used[4] = next_floor_tile;
+
+    view_area = render_area_a * render_area_b;
+    base_area = RENDER_POOLS_BASE_AREA * RENDER_POOLS_BASE_AREA;
+
+    for (i = 0; render_pools[i].Name != NULL; i++)
+    {
+        s32 new_n;
+
+        p_pool = &render_pools[i];
+        if (p_pool->BaseN == 0)
+            p_pool->BaseN = *p_pool->Limit;
+        if (p_pool->HighWater < used[i])
+            p_pool->HighWater = used[i];
+
+        new_n = 0;
+        // Requests which did not fit are not counted, so treat a pool which
+        // is nearly full as overflowing
+        if (used[i] + (*p_pool->Limit >> 5) >= *p_pool->Limit) {
+            p_pool->FullFrames++;
+            new_n = *p_pool->Limit + (*p_pool->Limit >> 1);
+        }
+        // Wider view needs more of everything
+        if ((ingame.LowerMemoryUse != 1) && (view_area > base_area)) {
+            s32 area_n;
+            area_n = (s64)p_pool->BaseN * view_area / base_area;
+            if (new_n < area_n)
+                new_n = area_n;
+        }
+        if ((new_n > *p_pool->Limit) && (*p_pool->Limit < p_pool->IndexLimit))
+            render_pool_grow(p_pool, new_n);
+    }
+}
+
+void render_pools_report(void)
+{
+    struct RenderPool *p_pool;
+    int i;
+
+    for (i = 0; render_pools[i].Name != NULL; i++)
+    {
+        p_pool = &render_pools[i];
+        LOGSYNC("Pool %s: high-water %ld of %ld, nearly full in %lu frames",
+          p_pool->Name, (long)p_pool->HighWater, (long)*p_pool->Limit,
+          p_pool->FullFrames);
+    }
+}
+
 void init_things_memory_with_user_heap(void)
 {
     ubyte *buf;
@@ -106,6 +106,18 @@ void adjust_memory_use(void);
 TbResult init_memory(MemSystem *mem_table);
 int get_memory_ptr_allocated_count(void **mgptr);
 TbResult propagate_memory_sizes(void);
+
+/** Updates usage statistics of drawlist pools, and grows the pools which
+ * are too small for the current view.
+ *
+ * Needs to be called between frames, after the drawlist was drawn
+ * and before it is reset.
+ */
+void render_pools_frame_end(void);
+
+/** Writes high-water marks of drawlist pools to the log.
+ */
+void render_pools_report(void);
 void init_things_memory_with_user_heap(void);
 
 /******************************************************************************/
@@ -0,0 +1,196 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file game_prof.c
+ *     Per-subsystem frame time profiler.
+ * @par Purpose:
+ *     Measures time spent in main phases of each game turn, and presents
+ *     the results as on-screen overlay or as CSV file rows.
+ * @par Comment:
+ *     Disabled by default; begin/end calls cost almost nothing then.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "game_prof.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "bffile.h"
+#include "bfmemut.h"
+#include "bfscreen.h"
+#include "bftime.h"
+
+#include "drawtext.h"
+#include "engincolour.h"
+#include "game_data.h"
+#include "game_sprts.h"
+#include "swlog.h"
+/******************************************************************************/
+
+ubyte frame_prof_flags = FPrF_None;
+
+static const char *frame_prof_phase_names[] = {
+    "packets",
+    "things",
+    "sthings",
+    "ppl_intel",
+    "engine",
+    "dl_fill",
+    "dl_draw",
+    "hud",
+    "swap",
+};
+
+/** Start times of phases in progress. */
+static TbClockUSec phase_start[FPrPh_COUNT];
+/** Times accumulated by phases in the current turn, in microseconds. */
+static u32 phase_turn_time[FPrPh_COUNT];
+/** Times of phases in recent turns, in microseconds. */
+static u32 phase_history[FRAME_PROF_HISTORY_TURNS][FPrPh_COUNT];
+static ushort phase_history_pos = 0;
+/** Time when the previous turn ended; used to get full turn duration. */
+static TbClockUSec last_turn_end = 0;
+static u32 turn_time_history[FRAME_PROF_HISTORY_TURNS];
+
+static TbFileHandle frame_prof_csv_fh = INVALID_FILE;
+
+/******************************************************************************/
+
+void frame_prof_begin(ubyte phase)
+{
+    if (frame_prof_flags == FPrF_None)
+        return;
+    phase_start[phase] = LbTimerClockMicro();
+}
+
+void frame_prof_end(ubyte phase)
+{
+    if (frame_prof_flags == FPrF_None)
+        return;
+    phase_turn_time[phase] += LbTimerClockMicro() - phase_start[phase];
+}
+
+static void frame_prof_csv_open(void)
+{
+    char fname[DISKPATH_SIZE];
+    char locstr[256];
+    int i;
+
+    sprintf(fname, "%s/frmprof.csv", game_dirs[DirPlace_Savegame].directory);
+    frame_prof_csv_fh = LbFileOpen(fname, Lb_FILE_MODE_NEW);
+    if (frame_prof_csv_fh == INVALID_FILE) {
+        LOGERR("%s: Could not create profiler CSV file", fname);
+        frame_prof_flags &= ~FPrF_CsvRows;
+        return;
+    }
+    LOGSYNC("%s: Writing profiler rows", fname);
+    strcpy(locstr, "turn,total_us");
+    for (i = 0; i < FPrPh_COUNT; i++) {
+        strcat(locstr, ",");
+        strcat(locstr, frame_prof_phase_names[i]);
+        strcat(locstr, "_us");
+    }
+    strcat(locstr, "\n");
+    LbFileWrite(frame_prof_csv_fh, locstr, strlen(locstr));
+}
+
+void frame_prof_csv_close(void)
+{
+    if (frame_prof_csv_fh == INVALID_FILE)
+        return;
+    LbFileClose(frame_prof_csv_fh);
+    frame_prof_csv_fh = INVALID_FILE;
+}
+
+static void frame_prof_csv_write_row(GameTurn turn, u32 turn_time)
+{
+    char locstr[256];
+    char *s;
+    int i;
+
+    if (frame_prof_csv_fh == INVALID_FILE)
+        frame_prof_csv_open();
+    if (frame_prof_csv_fh == INVALID_FILE)
+        return;
+
+    s = locstr;
+    s += sprintf(s, "%lu,%lu", (ulong)turn, (ulong)turn_time);
+    for (i = 0; i < FPrPh_COUNT; i++) {
+        s += sprintf(s, ",%lu", (ulong)phase_turn_time[i]);
+    }
+    s += sprintf(s, "\n");
+    LbFileWrite(frame_prof_csv_fh, locstr, s - locstr);
+}
+
+void frame_prof_turn_end(GameTurn turn)
+{
+    TbClockUSec curr_time;
+    u32 turn_time;
+
+    if (frame_prof_flags == FPrF_None)
+        return;
+
+    curr_time = LbTimerClockMicro();
+    if (last_turn_end != 0)
+        turn_time = curr_time - last_turn_end;
+    else
+        turn_time = 0;
+    last_turn_end = curr_time;
+
+    if ((frame_prof_flags & FPrF_CsvRows) != 0)
+        frame_prof_csv_write_row(turn, turn_time);
+
+    LbMemoryCopy(phase_history[phase_history_pos], phase_turn_time, sizeof(phase_turn_time));
+    turn_time_history[phase_history_pos] = turn_time;
+    phase_history_pos = (phase_history_pos + 1) % FRAME_PROF_HISTORY_TURNS;
+    LbMemorySet(phase_turn_time, 0, sizeof(phase_turn_time));
+}
+
+static void snprint_avg_ms(char *buf, ulong buflen, const char *name, ulong sum_us)
+{
+    ulong avg_us;
+
+    avg_us = sum_us / FRAME_PROF_HISTORY_TURNS;
+    snprintf(buf, buflen, "%-9s %3lu.%02lu ms", name,
+      avg_us / 1000, (avg_us % 1000) / 10);
+}
+
+void frame_prof_draw_overlay(void)
+{
+    char locstr[40];
+    short scr_x, scr_y, ln;
+    ulong sum_us;
+    int i, k;
+
+    if ((frame_prof_flags & FPrF_Overlay) == 0)
+        return;
+
+    ln = 8 * pop1_sprites_scale;
+    scr_x = lbDisplay.GraphicsScreenWidth - 100 * pop1_sprites_scale;
+    scr_y = 30 * pop1_sprites_scale;
+
+    sum_us = 0;
+    for (k = 0; k < FRAME_PROF_HISTORY_TURNS; k++)
+        sum_us += turn_time_history[k];
+    snprint_avg_ms(locstr, sizeof(locstr), "turn", sum_us);
+    draw_text(scr_x, scr_y, locstr, colour_lookup[ColLU_WHITE]);
+    scr_y += ln;
+
+    for (i = 0; i < FPrPh_COUNT; i++)
+    {
+        sum_us = 0;
+        for (k = 0; k < FRAME_PROF_HISTORY_TURNS; k++)
+            sum_us += phase_history[k][i];
+        snprint_avg_ms(locstr, sizeof(locstr), frame_prof_phase_names[i], sum_us);
+        draw_text(scr_x, scr_y, locstr, colour_lookup[ColLU_WHITE]);
+        scr_y += ln;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,88 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file game_prof.h
+ *     Header file for game_prof.c.
+ * @par Purpose:
+ *     Per-subsystem frame time profiler.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef GAME_PROF_H
+#define GAME_PROF_H
+
+#include "bftypes.h"
+#include "game_bstype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Amount of game turns over which the overlay values are averaged.
+ */
+#define FRAME_PROF_HISTORY_TURNS 16
+
+/** Phases of a game turn measured by the profiler.
+ */
+enum FrameProfPhases {
+    FPrPh_PACKETS = 0,	/**< process_packets() */
+    FPrPh_THINGS,		/**< process_things(), loop over things */
+    FPrPh_STHINGS,		/**< process_things(), loop over simple things */
+    FPrPh_PEOPLE_INTEL,	/**< process_things(), people_intel() */
+    FPrPh_ENGINE,		/**< show_game_engine(), includes all the drawing phases below */
+    FPrPh_DRAWLIST_FILL,/**< engine_draw_things() */
+    FPrPh_DRAWLIST_DRAW,/**< draw_drawlist_2() */
+    FPrPh_HUD,			/**< draw_hud() */
+    FPrPh_SCREEN_SWAP,	/**< LbScreenSwap() and related */
+    FPrPh_COUNT,
+};
+
+enum FrameProfFlags {
+    FPrF_None = 0x00,
+    /** Show rolling averages of phase times on screen. */
+    FPrF_Overlay = 0x01,
+    /** Write times of each turn as a row of CSV file. */
+    FPrF_CsvRows = 0x02,
+};
+
+/******************************************************************************/
+extern ubyte frame_prof_flags;
+/******************************************************************************/
+
+/** Marks start of given phase within the current turn.
+ */
+void frame_prof_begin(ubyte phase);
+
+/** Marks end of given phase within the current turn.
+ * A phase can be started and ended multiple times in one turn;
+ * the times are summed.
+ */
+void frame_prof_end(ubyte phase);
+
+/** Finishes the current turn - stores its times in history,
+ * and writes CSV row if enabled.
+ */
+void frame_prof_turn_end(GameTurn turn);
+
+/** Draws the profiler overlay on current graphics window.
+ */
+void frame_prof_draw_overlay(void);
+
+/** Closes the CSV file, if it was opened.
+ */
+void frame_prof_csv_close(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
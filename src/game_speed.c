@@ -34,6 +34,13 @@ ushort game_num_fps = 16;
 
 ushort fifties_per_gameturn = 3;
 
+ushort render_max_fps = 0;
+
+ulong render_frame = 0;
+
+/** Time at which the current game turn has started. */
+static TbClockMSec last_loop_time = 0;
+
 /******************************************************************************/
 
 void frameskip_clip(void)
@@ -90,7 +97,6 @@ ubyte get_speed_control_inputs(void)
 
 void wait_next_gameturn(void)
 {
-    static TbClockMSec last_loop_time = 0;
     TbClockMSec curr_time = LbTimerClock();
     TbClockMSec sleep_end;
 
@@ -108,6 +114,47 @@ void wait_next_gameturn(void)
     last_loop_time = sleep_end;
 }
 
+TbBool render_interp_enabled(void)
+{
+    if (render_max_fps <= game_num_fps)
+        return false;
+    // With frame skip, we are trying to go faster than real time
+    return (frameskip == 0);
+}
+
+ushort gameturn_elapsed_fraction(void)
+{
+    TbClockMSec elapsed;
+    ulong fraction;
+
+    elapsed = LbTimerClock() - last_loop_time;
+    if (elapsed < 0)
+        return 0;
+    fraction = ((ulong)elapsed << 8) * game_num_fps / 1000;
+    if (fraction > 256)
+        fraction = 256;
+    return fraction;
+}
+
+TbBool wait_next_render_frame(void)
+{
+    TbClockMSec curr_time;
+    TbClockMSec frame_end, turn_end;
+    static TbClockMSec last_frame_time = 0;
+
+    curr_time = LbTimerClock();
+    turn_end = last_loop_time + 1000/game_num_fps;
+    frame_end = last_frame_time + 1000/render_max_fps;
+    if ((frame_end < curr_time) || (frame_end > curr_time + 1000/render_max_fps))
+        frame_end = curr_time;
+    // Do not start a frame which would end after the next turn should start
+    if (frame_end + 1000/render_max_fps > turn_end)
+        return false;
+    LbSleepUntil(frame_end);
+    last_frame_time = frame_end;
+    return true;
+}
+
 /**
  * Checks if the game screen needs redrawing.
  */
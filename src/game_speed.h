@@ -39,6 +39,15 @@ extern ushort fifties_per_gameturn;
  * turns per second. */
 extern ushort game_num_fps;
 
+/** Max amount of frames per second drawn by the game, if it is allowed
+ * to draw interpolated frames between game turns. Zero disables
+ * the interpolation, and the game draws one frame per turn. */
+extern ushort render_max_fps;
+
+/** Counter of drawn engine frames, including interpolated ones.
+ * Used to make sure an object is drawn only once per frame. */
+extern ulong render_frame;
+
 /**
  * Handles game speed control inputs.
  * @return Returns true if packet was created, false otherwise.
@@ -47,6 +56,21 @@ ubyte get_speed_control_inputs(void);
 
 void wait_next_gameturn(void);
 
+/** Returns whether interpolated frames should be drawn between game turns.
+ */
+TbBool render_interp_enabled(void);
+
+/** Returns how much of the current game turn time has passed,
+ * in range 0..256.
+ */
+ushort gameturn_elapsed_fraction(void);
+
+/** Waits until the next interpolated frame should be drawn.
+ * @return Returns false if there is no time for another frame before
+ *     the next game turn should start.
+ */
+TbBool wait_next_render_frame(void);
+
 TbBool display_needs_redraw_this_turn(void);
 void update_tick_time(void);
 
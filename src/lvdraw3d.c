@@ -41,6 +41,7 @@
 #include "enginsngtxtr.h"
 #include "game.h"
 #include "game_options.h"
+#include "game_prof.h"
 #include "game_speed.h"
 #include "player.h"
 #include "scanner.h"
@@ -305,7 +306,7 @@ void lvdraw_do_objects(int cor_z_beg, uint ranges_x_len, struct Range *ranges_x)
             if (objtng > 0)
             {
                 p_objtng = &things[objtng];
-                if (p_objtng->U.UObject.DrawTurn != gameturn)
+                if (p_objtng->U.UObject.DrawTurn != render_frame)
                     draw_thing_object(p_objtng);
             }
         }
@@ -845,6 +846,7 @@ void clear_super_quick_lights(void)
 
 void draw_screen(void)
 {
+    frame_prof_begin(FPrPh_DRAWLIST_DRAW);
     if (nuclear_overexposure)
     {
         draw_drawlist_1();
@@ -853,6 +855,7 @@ void draw_screen(void)
     {
         draw_drawlist_2();
     }
+    frame_prof_end(FPrPh_DRAWLIST_DRAW);
 #if 0
     //TODO Setting first palette colour was often used as debug helper; to be removed
     outp(0x3C8u, 0);
@@ -8,7 +8,7 @@
  * @par Comment:
  *     None.
  * @author   Tomasz Lis
- * @date     27 May 2022 - 12 Jun 2023
+ * @date     27 May 2022 - 17 Oct 2026
  * @par  Copying and copyrights:
  *     This program is free software; you can redistribute it and/or modify
  *     it under the terms of the GNU General Public License as published by
@@ -19,7 +19,19 @@
 #include "lvfiles.h"
 
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+# include <sys/mman.h>
+# define LVFILES_USE_MMAP 1
+#else
+# define LVFILES_USE_MMAP 0
+#endif
+#include "bfasync.h"
 #include "bffile.h"
 #include "bfmath.h"
 #include "bfmemut.h"
@@ -34,6 +46,8 @@
 #include "triangls.h"
 #include "trpoints.h"
 #include "trstate.h"
+#include "trfind8.h"
+#include "trroute.h"
 #include "pathtrig.h"
 #include "bigmap.h"
 #include "campaign.h"
@@ -70,6 +84,28 @@ struct BillboardNBreakout {
 };
 
 #pragma pack()
+
+/** Sequential reader of a file image held in memory.
+ */
+struct LevelBuffer {
+    const ubyte *Data;
+    ulong Size;
+    ulong Pos;
+};
+
+/** Image of the level file loaded most recently.
+ *
+ * Mission restart loads the same level again, so the file is kept in memory
+ * (mapped if possible) instead of being re-read from disk.
+ */
+struct LevelFileImage {
+    char Fname[DISKPATH_SIZE];
+    ubyte *Data;
+    ulong Size;
+    /** Modification time of the file when it was loaded. */
+    time_t MTime;
+    TbBool Mapped;
+};
 /******************************************************************************/
 
 TbBool level_deep_fix = false;
@@ -84,6 +120,8 @@ ulong stored_g3d_next_floor_texture;
 ulong stored_g3d_next_local_mat;
 ulong stored_global3d_inuse;
 
+static struct LevelFileImage level_file_image = {0};
+
 extern struct QuickLoad quick_load_pc[19];
 
 struct QuickLoad quick_load_pc[] = {
@@ -189,7 +227,112 @@ TbBool is_level_stored_sthing(struct SimpleThing *p_sthing)
     return false;
 }
 
-ulong load_level_pc_handle(TbFileHandle lev_fh)
+/** Reads given amount of bytes from the level buffer.
+ * Works like LbFileRead() - at end of the buffer, gives less bytes than requested.
+ */
+static long level_buffer_read(struct LevelBuffer *p_lvbuf, void *buf, ulong len)
+{
+    ulong remain;
+
+    remain = p_lvbuf->Size - p_lvbuf->Pos;
+    if (len > remain)
+        len = remain;
+    memcpy(buf, p_lvbuf->Data + p_lvbuf->Pos, len);
+    p_lvbuf->Pos += len;
+    return len;
+}
+
+static void level_file_image_free(void)
+{
+    struct LevelFileImage *p_lvimg;
+
+    p_lvimg = &level_file_image;
+#if LVFILES_USE_MMAP
+    if (p_lvimg->Mapped)
+        munmap(p_lvimg->Data, p_lvimg->Size);
+    else
+#endif
+        free(p_lvimg->Data);
+    p_lvimg->Data = NULL;
+    p_lvimg->Size = 0;
+    p_lvimg->MTime = 0;
+    p_lvimg->Mapped = false;
+    p_lvimg->Fname[0] = '\0';
+}
+
+/** Gets size and modification time of a file, without opening it.
+ */
+static TbResult level_file_stat(const char *fname, struct stat *p_st)
+{
+#if LB_FILENAME_TRANSFORM
+    char trans_fname[FILENAME_MAX];
+
+    if (lbFileNameTransform != NULL)
+    {
+        lbFileNameTransform(trans_fname, fname);
+        fname = trans_fname;
+    }
+#endif
+    if (stat(fname, p_st) != 0)
+        return Lb_FAIL;
+    return Lb_SUCCESS;
+}
+
+/** Gives image of given level file in memory, loading it if not loaded already.
+ */
+static struct LevelFileImage *level_file_image_get(const char *fname)
+{
+    struct LevelFileImage *p_lvimg;
+    struct stat st;
+    TbFileHandle fh;
+    long len;
+
+    p_lvimg = &level_file_image;
+    // Reuse the image if the file did not change; mostly happens on mission restart
+    if (level_file_stat(fname, &st) != Lb_SUCCESS)
+        st.st_mtime = 0;
+    else if ((p_lvimg->Data != NULL) && (st.st_size == (off_t)p_lvimg->Size) &&
+      (st.st_mtime == p_lvimg->MTime) && (strcmp(p_lvimg->Fname, fname) == 0))
+        return p_lvimg;
+
+    fh = LbFileOpen(fname, Lb_FILE_MODE_READ_ONLY);
+    if (fh == INVALID_FILE)
+        return NULL;
+    len = LbFileLengthHandle(fh);
+    level_file_image_free();
+    if ((len <= 0) || (strlen(fname) >= sizeof(p_lvimg->Fname))) {
+        LbFileClose(fh);
+        return NULL;
+    }
+#if LVFILES_USE_MMAP
+    {
+        void *map;
+
+        map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, (int)fh, 0);
+        if (map != MAP_FAILED) {
+            p_lvimg->Data = map;
+            p_lvimg->Mapped = true;
+        }
+    }
+#endif
+    if (p_lvimg->Data == NULL)
+    {
+        p_lvimg->Data = malloc(len);
+        if ((p_lvimg->Data == NULL) || (LbFileRead(fh, p_lvimg->Data, len) != len)) {
+            LOGERR("%s: Could not read level file", fname);
+            LbFileClose(fh);
+            level_file_image_free();
+            return NULL;
+        }
+    }
+    LbFileClose(fh);
+    p_lvimg->Size = len;
+    p_lvimg->MTime = st.st_mtime;
+    strcpy(p_lvimg->Fname, fname);
+    return p_lvimg;
+}
+
+static ulong load_level_pc_buffer(struct LevelBuffer *p_lvbuf)
 {
     u32 fmtver;
     TbBool mech_initialized;
@@ -198,7 +341,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
 
     mech_initialized = 0;
     fmtver = 0;
-    LbFileRead(lev_fh, &fmtver, sizeof(u32));
+    level_buffer_read(p_lvbuf, &fmtver, sizeof(u32));
 
     if (fmtver >= 1)
     {
@@ -208,7 +351,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
         struct Thing *p_thing;
 
         count = 0;
-        LbFileRead(lev_fh, &count, 2);
+        level_buffer_read(p_lvbuf, &count, 2);
 
         LOGSYNC("Level fmtver=%lu n_things=%hd", fmtver, count);
         for (i = 0; i < count; i++)
@@ -223,11 +366,11 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
             memcpy(&loc_thing, p_thing, sizeof(struct Thing));
             if (fmtver >= 13) {
                 assert(sizeof(struct Thing) == 168);
-                LbFileRead(lev_fh, p_thing, sizeof(struct Thing));
+                level_buffer_read(p_lvbuf, p_thing, sizeof(struct Thing));
             } else {
                 struct ThingOldV9 s_oldthing;
                 assert(sizeof(s_oldthing) == 216); // the sizeof(Thing) was 216 since fmtver=2
-                LbFileRead(lev_fh, &s_oldthing, sizeof(s_oldthing));
+                level_buffer_read(p_lvbuf, &s_oldthing, sizeof(s_oldthing));
                 refresh_old_thing_format(p_thing, &s_oldthing, fmtver);
             }
 
@@ -314,7 +457,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
                     assert(sizeof(struct M33) == 36);
                     assert(next_local_mat < LOCAL_MATS_COUNT);
                     matx = next_local_mat++;
-                    LbFileRead(lev_fh, &local_mats[matx], sizeof(struct M33));
+                    level_buffer_read(p_lvbuf, &local_mats[matx], sizeof(struct M33));
                     p_thing->U.UVehicle.MatrixIndex = matx;
                 }
                 byte_1C83D1 = 0;
@@ -373,18 +516,18 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
             }
         }
     }
-    LbFileRead(lev_fh, &next_command, sizeof(ushort));
+    level_buffer_read(p_lvbuf, &next_command, sizeof(ushort));
     limit = get_memory_ptr_allocated_count((void **)&game_commands);
     if ((limit >= 0) && (next_command > limit)) {
         LOGERR("Restricting \"%s\", wanted %d, limit %ld", "game_commands", (int)next_command, limit);
         next_command = limit;
     }
     assert(sizeof(struct Command) == 32);
-    LbFileRead(lev_fh, game_commands, sizeof(struct Command) * next_command);
+    level_buffer_read(p_lvbuf, game_commands, sizeof(struct Command) * next_command);
 
     if (fmtver >= 2)
     {
-        LbFileRead(lev_fh, &level_def, 44);
+        level_buffer_read(p_lvbuf, &level_def, 44);
     }
     for (i = 0; i < 8; i++)
     {
@@ -393,8 +536,8 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
     }
     if (fmtver >= 3)
     {
-        LbFileRead(lev_fh, engine_mem_alloc_ptr + engine_mem_alloc_size - 1320 - 33, 1320);
-        LbFileRead(lev_fh, war_flags, 32 * sizeof(struct WarFlag));
+        level_buffer_read(p_lvbuf, engine_mem_alloc_ptr + engine_mem_alloc_size - 1320 - 33, 1320);
+        level_buffer_read(p_lvbuf, war_flags, 32 * sizeof(struct WarFlag));
     }
     for (k = 0; k < PEOPLE_GROUPS_COUNT; k++)
     {
@@ -406,10 +549,10 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
     }
     if (fmtver >= 3)
     {
-        LbFileRead(lev_fh, &word_1531E0, sizeof(ushort));
-        LbFileRead(lev_fh, engine_mem_alloc_ptr + engine_mem_alloc_size - 32000, 15 * word_1531E0);
-        LbFileRead(lev_fh, &unkn3de_len, sizeof(ushort));
-        LbFileRead(lev_fh, engine_mem_alloc_ptr + engine_mem_alloc_size - 32000, unkn3de_len);
+        level_buffer_read(p_lvbuf, &word_1531E0, sizeof(ushort));
+        level_buffer_read(p_lvbuf, engine_mem_alloc_ptr + engine_mem_alloc_size - 32000, 15 * word_1531E0);
+        level_buffer_read(p_lvbuf, &unkn3de_len, sizeof(ushort));
+        level_buffer_read(p_lvbuf, engine_mem_alloc_ptr + engine_mem_alloc_size - 32000, unkn3de_len);
     }
     LOGSYNC("Level fmtver=%lu n_command=%hu word_1531E0=%hu unkn3de_len=%hu",
       (ulong)fmtver, next_command, word_1531E0, unkn3de_len);
@@ -419,7 +562,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
         ThingIdx thing;
 
         count = 0;
-        LbFileRead(lev_fh, &count, 2);
+        level_buffer_read(p_lvbuf, &count, 2);
         for (i = count; i > 0; i--)
         {
             struct SimpleThing loc_thing;
@@ -428,7 +571,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
             thing = get_new_sthing();
             p_thing = &sthings[thing];
             memcpy(&loc_thing, p_thing, 60);
-            LbFileRead(lev_fh, p_thing, 60);
+            level_buffer_read(p_lvbuf, p_thing, 60);
 
             if (!is_level_stored_sthing(p_thing))
             {
@@ -479,7 +622,7 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
 
     if (fmtver >= 6)
     {
-        LbFileRead(lev_fh, &game_level_unique_id, 2);
+        level_buffer_read(p_lvbuf, &game_level_unique_id, 2);
         if (game_level_unique_id < 1000)
             game_level_unique_id = 1000;
         if (game_level_unique_id > 9000)
@@ -487,9 +630,9 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
     }
 
     if (fmtver >= 7) {
-        LbFileRead(lev_fh, &next_used_lvl_objective, sizeof(ushort));
+        level_buffer_read(p_lvbuf, &next_used_lvl_objective, sizeof(ushort));
         assert(sizeof(struct Objective) == 32);
-        n = LbFileRead(lev_fh, game_used_lvl_objectives, sizeof(struct Objective) * next_used_lvl_objective);
+        n = level_buffer_read(p_lvbuf, game_used_lvl_objectives, sizeof(struct Objective) * next_used_lvl_objective);
         if (n < (int)sizeof(struct Objective) * next_used_lvl_objective)
             LOGWARN("Array used_lvl_objectives truncated, got %d bytes", n);
     } else {
@@ -497,21 +640,21 @@ ulong load_level_pc_handle(TbFileHandle lev_fh)
     }
 
     if (fmtver >= 9) {
-        LbFileRead(lev_fh, game_level_unkn1, 40);
-        LbFileRead(lev_fh, game_level_unkn2, 40);
+        level_buffer_read(p_lvbuf, game_level_unkn1, 40);
+        level_buffer_read(p_lvbuf, game_level_unkn2, 40);
     }
 
     if (fmtver >= 10) {
         // An older file format had this struct with sizeof=20,
         // but we don't know the speciifc fmtver range for that
         assert(sizeof(struct LevelMisc) == 22);
-        n = LbFileRead(lev_fh, game_level_miscs, sizeof(struct LevelMisc) * 200);
+        n = level_buffer_read(p_lvbuf, game_level_miscs, sizeof(struct LevelMisc) * 200);
         if (n < (int)sizeof(struct LevelMisc) * 200)
             LOGWARN("Array level_miscs truncated, got %d bytes", n);
     }
 
     if (fmtver >= 16) {
-        n = LbFileRead(lev_fh, &engn_anglexz, 4);
+        n = level_buffer_read(p_lvbuf, &engn_anglexz, 4);
         if (n < 4)
             LOGWARN("Field anglexz truncated, got %d bytes", n);
     }
@@ -530,6 +673,9 @@ void save_level_pc_handle(TbFileHandle lev_fh)
     assert(sizeof(struct Objective) == 32);
     assert(sizeof(struct LevelMisc) == 22);
 
+    // The file being written may be the one kept in memory
+    level_file_image_free();
+
     fmtver = 18;
     LbFileWrite(lev_fh, &fmtver, sizeof(u32));
 
@@ -1044,7 +1190,7 @@ TbBool level_misc_get_starting_camera_pos(MapCoord *cor_x, MapCoord *cor_z)
 void load_level_pc(short level, short missi, ubyte reload)
 {
     short next_level, prev_level;
-    TbFileHandle lev_fh;
+    struct LevelFileImage *p_lvimg;
     char lev_fname[52];
 
     next_level = level;
@@ -1081,18 +1227,20 @@ void load_level_pc(short level, short missi, ubyte reload)
     }
     debug_level(" load level restart coms", 1);
 
-    lev_fh = LbFileOpen(lev_fname, Lb_FILE_MODE_READ_ONLY);
-    if (lev_fh != INVALID_FILE)
+    p_lvimg = level_file_image_get(lev_fname);
+    if (p_lvimg != NULL)
     {
+        struct LevelBuffer lvbuf;
         u32 fmtver;
         int i;
 
         word_1C8446 = 1;
         word_176E38 = 0;
 
-        fmtver = load_level_pc_handle(lev_fh);
-
-        LbFileClose(lev_fh);
+        lvbuf.Data = p_lvimg->Data;
+        lvbuf.Size = p_lvimg->Size;
+        lvbuf.Pos = 0;
+        fmtver = load_level_pc_buffer(&lvbuf);
 
         if (fmtver < 5)
             add_commands_from_person_states();
@@ -1286,6 +1434,7 @@ void load_map_dat_pc_handle(TbFileHandle fh)
             refresh_old_full_light_format(&game_full_lights[i], &old_full_light, fmtver);
         }
     }
+    quick_lights_shade_cache_invalidate();
     {
         LbFileRead(fh, &next_normal, sizeof(next_normal));
         LbFileRead(fh, game_normals, sizeof(struct Normal) * next_normal);
@@ -1518,6 +1667,9 @@ void load_mad_pc_buffer(ubyte *mad_ptr, long rdsize)
     assert(sizeof(struct Triangulation) == 60);
     memcpy(triangulation, mad_ptr, sizeof(struct Triangulation) * 4);
     mad_ptr += sizeof(struct Triangulation) * 4;
+    // Hints and routes from previous map would only send searches to a wrong area
+    triangle_find_hints_clear_all();
+    triangle_route_cache_clear();
     assert(sizeof(struct TrTriangle) == 16);
     triangulation[0].Triangles = (struct TrTriangle *)mad_ptr;
     mad_ptr += sizeof(struct TrTriangle) * triangulation[0].max_Triangles;
@@ -1645,17 +1797,35 @@ void prepare_map_dat_to_play(void)
     generate_map_triangulation();
 }
 
+static void format_map_mad_fname(char *mad_fname, ushort mapno)
+{
+    PathInfo *pinfo;
+
+    pinfo = &game_dirs[DirPlace_Maps];
+    snprintf(mad_fname, DISKPATH_SIZE-1, "%s/map%03d.mad", pinfo->directory, mapno);
+}
+
+void prefetch_map_mad(ushort mapno)
+{
+    char mad_fname[DISKPATH_SIZE];
+
+    if (mapno == 0)
+        return;
+    format_map_mad_fname(mad_fname, mapno);
+    if (LbAsyncFileRequest(mad_fname) != Lb_SUCCESS)
+        LOGSYNC("Could not queue background load of \"%s\"", mad_fname);
+}
+
 TbResult load_map_mad(ushort mapno)
 {
     char mad_fname[DISKPATH_SIZE];
-    PathInfo *pinfo;
     long fsize;
 
     next_local_mat = 1;
 
-    pinfo = &game_dirs[DirPlace_Maps];
-    snprintf(mad_fname, DISKPATH_SIZE-1, "%s/map%03d.mad", pinfo->directory, mapno);
-    fsize = LbFileLoadAt(mad_fname, scratch_malloc_mem);
+    format_map_mad_fname(mad_fname, mapno);
+    // If the file was prefetched, keep the window responsive while waiting for it
+    fsize = LbAsyncFileLoadAt(mad_fname, scratch_malloc_mem, game_handle_sdl_events);
     if (fsize == Lb_FAIL)
         return Lb_FAIL;
 
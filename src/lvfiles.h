@@ -68,6 +68,13 @@ extern ushort next_used_lvl_objective;
 
 TbResult load_mad_pc(ushort mapno);
 
+/** Starts loading the map file on background thread.
+ *
+ * The map loading later collects the data, only waiting if the background
+ * load did not finish yet.
+ */
+void prefetch_map_mad(ushort mapno);
+
 void load_level_pc(short level, short missi, ubyte reload);
 
 /** Get start position for in-mission camera from misc entry with mounted gun.
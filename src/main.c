@@ -10,11 +10,15 @@
 #include "swlog.h"
 #include "bfjoyst.h"
 #include "display.h"
+#include "enginrscale.h"
 #include "guitext.h"
 #include "game.h"
+#include "game_bench.h"
 #include "game_data.h"
+#include "game_prof.h"
 #include "game_options.h"
 #include "game_save.h"
+#include "game_speed.h"
 #include "lvfiles.h"
 #include "lvobjctv.h"
 #include "network.h"
@@ -86,7 +90,7 @@ print_help (const char *argv0)
 "                          events/interrupts\n"
 "                -d <str>  Activate debug functions; t - things debug HUD,\n"
 "                          o - objectives debug HUD, c - collision debug HUD\n"
-"                          v - navigation perf HUD\n"
+"                          v - navigation perf HUD, f - frame profiler HUD\n"
 "                -E <num>  Joystick config\n"
 "                -F        Re-compute and re-save `tables.dat` colour tables\n"
 "                          file, using `fade.dat` as input\n"
@@ -98,13 +102,16 @@ print_help (const char *argv0)
 "                          network address\n"
 "                -l <str>  Activate additional logging; s - thing states and\n"
 "                          commands; p - player actions and packets; w - weapon\n"
-"                          shooting and projectiles\n"
+"                          shooting and projectiles; f - frame profiler times\n"
+"                          of each turn, to CSV file in savegame dir\n"
 "                -m <n>,<n> Load campaign with given index, from which load\n"
 "                          mission with given index in single map mode\n"
 "                -N        Sets a flag which is never used. Debug feature?\n"
 "                -p <num>  Play replay packets from file of given index;\n"
 "                          use '-m' to specify mission on which to play\n"
 "                -q        Skip intro movie\n"
+"  --render-fps  -R <num>  Draw up to given amount of frames per second, with\n"
+"                          interpolated frames between game turns\n"
 "                -r        Record replay packets to file in savegame dir;\n"
 "                          next unused filename for selected map will be used\n"
 "  --level-deep-fix -L     Perform deeper fixes to the loaded levels; this may\n"
@@ -117,8 +124,16 @@ print_help (const char *argv0)
 "                          file, using palette file as input\n"
 "  --self-tests  -t        Execute build self tests\n"
 "                -u <str>  Set user name (login / network name) string\n"
+"  --render-scale -V <num> Draw 3D view at given percent of screen resolution,\n"
+"                          50-100, and stretch it; HUD stays at full resolution\n"
 "  --windowed    -W        Run in windowed mode\n"
-"                -w        Lower memory use; decreases size of static arrays\n",
+"                -w        Lower memory use; decreases size of static arrays\n"
+"  --bench-replay <c> <m> <n> Headless benchmark; play replay packets file of\n"
+"                          index <n> on campaign <c> mission <m>, without\n"
+"                          drawing, sound or speed limit; report simulation\n"
+"                          speed and world checksum\n"
+"  --bench-expect-checksum <hex> Fail the headless benchmark with exit code 2\n"
+"                          if world checksum at end differs from given one\n",
   argv0);
 }
 
@@ -183,13 +198,17 @@ static TbBool process_options(int *argc, char ***argv)
       {"level-deep-fix", 0, NULL, 'L'},
       {"self-test",   0, NULL, 't'},
       {"help",        0, NULL, 'h'},
+      {"bench-replay", 1, NULL, 'b'},
+      {"bench-expect-checksum", 1, NULL, 'k'},
+      {"render-fps",  1, NULL, 'R'},
+      {"render-scale", 1, NULL, 'V'},
       {NULL,          0, NULL,  0 },
     };
 
     argv0 = (*argv)[0];
     index = 0;
 
-    while ((val = getopt_long (*argc, *argv, "ABCDd:E:FgHhI:Ll:m:Np:qrSs:Ttu:Ww", options, &index)) >= 0)
+    while ((val = getopt_long (*argc, *argv, "ABCDd:E:FgHhI:Ll:m:Np:qR:rSs:Ttu:V:Ww", options, &index)) >= 0)
     {
         LOGDBG("Command line option: '%c'", val);
         switch (val)
@@ -207,6 +226,41 @@ static TbBool process_options(int *argc, char ***argv)
             cmdln_param_bcg = 100;
             break;
 
+        case 'b':
+        {
+            int campgn, missi, recno;
+
+            // The option takes three parameters; consume the two additional ones
+            if ((optind + 1 >= *argc) ||
+              (sscanf(optarg, "%d", &campgn) != 1) ||
+              (sscanf((*argv)[optind], "%d", &missi) != 1) ||
+              (sscanf((*argv)[optind+1], "%d", &recno) != 1))
+            {
+                LOGERR("Invalid value after '--bench-replay' parameter. Required three ints.");
+                return false;
+            }
+            optind += 2;
+            bench_replay_setup(campgn, missi, recno);
+            cmdln_fullscreen = false;
+            // No window should be shown when benchmarking
+            SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+            LOGDBG("bench replay campaign %d mission %d packet file %d", campgn, missi, recno);
+            break;
+        }
+
+        case 'k':
+        {
+            ulong csum;
+
+            if (sscanf(optarg, "%lx", &csum) != 1)
+            {
+                LOGERR("Invalid value after '--bench-expect-checksum' parameter. Required hex number.");
+                return false;
+            }
+            bench_replay_expect_checksum(csum);
+            break;
+        }
+
         case 'D':
             keyboard_mode_direct = 1;
             break;
@@ -228,6 +282,9 @@ static TbBool process_options(int *argc, char ***argv)
                 case 'v':
                     ingame.Flags |= GamF_NaviPerfInfo;
                     break;
+                case 'f':
+                    frame_prof_flags |= FPrF_Overlay;
+                    break;
                 default:
                     LOGERR("Invalid value after '-d' parameter. Unexpected char '%c'.", optarg[tmpint]);
                     return false;
@@ -283,6 +340,9 @@ static TbBool process_options(int *argc, char ***argv)
                 case 'w':
                     debug_log_things |= 0x04;
                     break;
+                case 'f':
+                    frame_prof_flags |= FPrF_CsvRows;
+                    break;
                 default:
                     LOGERR("Invalid value after '-l' parameter. Unexpected char '%c'.", optarg[tmpint]);
                     return false;
@@ -319,6 +379,16 @@ static TbBool process_options(int *argc, char ***argv)
             ingame.Flags |= GamF_SkipIntro;
             break;
 
+        case 'R':
+            tmpint = atoi(optarg);
+            if (tmpint < 0)
+                tmpint = 0;
+            else if (tmpint > 250)
+                tmpint = 250;
+            render_max_fps = tmpint;
+            LOGDBG("render max FPS %hu", render_max_fps);
+            break;
+
         case 'r':
             pktrec_mode = PktR_RECORD;
             LOGDBG("packet file record enabled");
@@ -347,6 +417,11 @@ static TbBool process_options(int *argc, char ***argv)
             LOGDBG("user name '%s'", user_name);
             break;
 
+        case 'V':
+            engine_render_scale_set(atoi(optarg));
+            LOGDBG("engine render scale %hu%%", (ushort)engine_render_scale);
+            break;
+
         case 'W':
             cmdln_fullscreen = false;
             break;
@@ -134,6 +134,7 @@ void (*my_build_packet)(struct Packet *packet, ushort action, u32 param1, s32 x,
 extern TbFileHandle packet_rec_fh;
 ushort packet_rec_no = 0;
 ubyte packet_rec_use_levelno = 0;
+ushort packet_rec_seed = 0;
 
 const char * get_packet_action_name(ushort atype)
 {
@@ -592,6 +593,7 @@ TbResult PacketRecord_Read(struct Packet *p_pckt, ushort dblmode)
 
     nread += LbFileRead(packet_rec_fh, &locbuf[0], 1 * sizeof(ushort));
     len++;
+    packet_rec_seed = locbuf[0];
 #if 0 //TODO fix the check
     if (locbuf[0] != lbSeed) {
         LOGSYNC("Packet desync - seed mismatch");
@@ -197,6 +197,8 @@ extern void (*my_build_packet)(struct Packet *packet, ushort action, u32 param1,
 extern ubyte pktrec_mode;
 extern ushort packet_rec_no;
 extern ubyte packet_rec_use_levelno;
+/** Lower bits of random seed stored with the last turn read from packet file. */
+extern ushort packet_rec_seed;
 
 const char * get_packet_action_name(ushort atype);
 const char * get_packet_action_result_text(short result);
@@ -20,6 +20,7 @@
 
 #include "bfmath.h"
 #include "bfmemory.h"
+#include "bfmemut.h"
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
@@ -32,12 +33,15 @@
 #include "game_data.h"
 #include "lvwalk.h"
 #include "thing.h"
+#include "thing_sight.h"
 #include "tngcolisn.h"
 #include "triangls.h"
 #include "tringops.h"
 #include "trpoints.h"
 #include "trstate.h"
 #include "trfringe.h"
+#include "trfind8.h"
+#include "trroute.h"
 #include "delaunay.h"
 #include "swlog.h"
 /******************************************************************************/
@@ -45,6 +49,11 @@ extern long ixE;
 extern long thin_wall_x1, thin_wall_y1;
 extern long thin_wall_x2, thin_wall_y2;
 
+extern s32 tree_Ax8, tree_Ay8;
+extern s32 tree_Bx8, tree_By8;
+extern int route_bak[3000];
+extern struct Path fwd_path;
+
 extern short link__MapColListEmptyHead;
 extern short link__MapColVectEmptyHead;
 
@@ -78,6 +87,136 @@ void path_init8_unkn3(struct Path *path, int ax8, int ay8, int bx8, int by8, int
         : : "a" (path), "d" (ax8), "b" (ay8), "c" (bx8), "g" (by8), "g" (a6));
 }
 
+static int triangle_route_do_unkn5(int tri_beg, int tri_end, int *route)
+{
+    int ret;
+    asm volatile ("call ASM_triangle_route_do_unkn5\n"
+        : "=a" (ret), "+d" (tri_end), "+b" (route)
+        : "0" (tri_beg) : "ecx", "memory");
+    return ret;
+}
+
+static int triangle_route_do_unkn6(int tri_beg, int tri_end, int *route)
+{
+    int ret;
+    asm volatile ("call ASM_triangle_route_do_unkn6\n"
+        : "=a" (ret), "+d" (tri_end), "+b" (route)
+        : "0" (tri_beg) : "ecx", "memory");
+    return ret;
+}
+
+/** Stack arguments of route_to_path(), to be pushed independently of
+ * where the compiler keeps the local variables.
+ */
+struct RouteToPathArgs {
+    int *route;
+    int route_len;
+    struct Path *p_path;
+    int *p_cost;
+};
+
+static int route_to_path(int ax8, int ay8, int bx8, int by8,
+  int *route, int route_len, struct Path *p_path, int *p_cost)
+{
+    struct RouteToPathArgs args;
+    int ret;
+
+    args.route = route;
+    args.route_len = route_len;
+    args.p_path = p_path;
+    args.p_cost = p_cost;
+    asm volatile (
+      "push 12(%5)\n"
+      "push 8(%5)\n"
+      "push 4(%5)\n"
+      "push (%5)\n"
+      "call ASM_route_to_path\n"
+        : "=a" (ret), "+d" (ay8), "+b" (bx8), "+c" (by8)
+        : "0" (ax8), "S" (&args) : "memory");
+    return ret;
+}
+
+/** Runs corridor search between triangles, or gets its result from cache.
+ *
+ * The search heuristic uses tile of the current `tree_Ax8`,`tree_Ay8` point,
+ * so that is a part of the cache key.
+ */
+static int triangle_route_corridor(ubyte kind, int tri_from, int tri_to, int *route)
+{
+    int len;
+    s32 heur_x, heur_y;
+
+    heur_x = tree_Ax8 >> 8;
+    heur_y = tree_Ay8 >> 8;
+    len = triangle_route_cache_get(kind, tri_from, tri_to, heur_x, heur_y, route);
+    if (len != TRIANGLE_ROUTE_NOT_CACHED)
+        return len;
+
+    if (kind == TrRSrch_Backward)
+        len = triangle_route_do_unkn6(tri_from, tri_to, route);
+    else
+        len = triangle_route_do_unkn5(tri_from, tri_to, route);
+
+    triangle_route_cache_put(kind, tri_from, tri_to, heur_x, heur_y, route, len);
+    return len;
+}
+
+static void tree_points_swap(void)
+{
+    s32 tmp;
+
+    tmp = tree_Ax8;
+    tree_Ax8 = tree_Bx8;
+    tree_Bx8 = tmp;
+    tmp = tree_Ay8;
+    tree_Ay8 = tree_By8;
+    tree_By8 = tmp;
+}
+
+int ma_triangle_route_3(int tri_beg, int tri_end, int *route, int *cost)
+{
+#if 0
+    int ret;
+    asm volatile ("call ASM_ma_triangle_route_3\n"
+        : "=a" (ret), "+d" (tri_end), "+b" (route), "+c" (cost)
+        : "0" (tri_beg) : "memory");
+    return ret;
+#endif
+    int len_bwd, len_fwd;
+    int cost_bwd, cost_fwd;
+    int i;
+
+    // The cost pointer is only given to the searches, which do not use it
+    (void)cost;
+
+    // Groups sent to the same place reuse corridor searches; converting
+    // the corridor to a path depends on exact points, so is always done
+    tree_points_swap();
+    len_bwd = triangle_route_corridor(TrRSrch_Backward, tri_end, tri_beg, route_bak);
+    if (len_bwd == -1)
+        return -1;
+    if (route_to_path(tree_Ax8, tree_Ay8, tree_Bx8, tree_By8,
+      route_bak, len_bwd, &fwd_path, &cost_bwd) == -1)
+        return -1;
+
+    tree_points_swap();
+    len_fwd = triangle_route_corridor(TrRSrch_Forward, tri_beg, tri_end, route);
+    if (len_fwd == -1) {
+        cost_fwd = INT_MAX;
+    } else {
+        if (route_to_path(tree_Ax8, tree_Ay8, tree_Bx8, tree_By8,
+          route, len_fwd, &fwd_path, &cost_fwd) == -1)
+            return -1;
+    }
+
+    if (cost_fwd < cost_bwd)
+        return len_fwd;
+
+    for (i = 0; i <= len_bwd; i++)
+        route[i] = route_bak[len_bwd - i];
+    return len_bwd;
+}
+
 //TODO temp copy of static func
 static sbyte path_compare_multiplications(long mul1a, long mul1b, long mul2a, long mul2b)
 {
@@ -173,6 +312,20 @@ int pointed_at8(TrFineCoord pt_x, TrFineCoord pt_y, int *r_tri, int *r_cor)
 #endif
 }
 
+/** Finds triangle containing given point by checking all triangles.
+ */
+static int triangle_find8_scan(TrFineCoord pt_x, TrFineCoord pt_y)
+{
+    int tri;
+
+    for (tri = 0; tri < triangulation[0].ix_Triangles; tri++)
+    {
+        if (tri_is_allocated(tri) && triangle_contains8(tri, pt_x, pt_y))
+            return tri;
+    }
+    return -1;
+}
+
 int triangle_find8(TrFineCoord pt_x, TrFineCoord pt_y)
 {
 #if 0
@@ -184,18 +337,14 @@ int triangle_find8(TrFineCoord pt_x, TrFineCoord pt_y)
     int tri; //TODO switch type to TrTriangId
     int remain;
 
-    tri = triangulation[0].last_tri;
+    // Start the walk from a triangle found near that point before, if any
+    tri = triangle_find_hint(pt_x, pt_y);
+    if (tri < 0)
+        tri = triangulation[0].last_tri;
 
     if (!tri_is_allocated(tri))
     {
-        for (tri = 0; tri < triangulation[0].ix_Triangles; tri++)
-        {
-            if (tri_is_allocated(tri) && triangle_contains8(tri, pt_x, pt_y))
-                break;
-        }
-        if (tri >= triangulation[0].ix_Triangles) {
-            tri = -1;
-        }
+        tri = triangle_find8_scan(pt_x, pt_y);
         triangulation[0].last_tri = tri;
         return tri;
     }
@@ -211,8 +360,8 @@ int triangle_find8(TrFineCoord pt_x, TrFineCoord pt_y)
 
         remain--;
         if (remain <= 0) {
-            tri = -1;
-            LOGERR("Cannot find (%d,%d)", pt_x, pt_y);
+            LOGDBG("Cannot find (%d,%d) by walking, scanning", pt_x, pt_y);
+            tri = triangle_find8_scan(pt_x, pt_y);
             break;
         }
         p_tri = &triangulation[0].Triangles[tri];
@@ -260,6 +409,8 @@ int triangle_find8(TrFineCoord pt_x, TrFineCoord pt_y)
     if (tri >= 0 && !triangle_contains8(tri, pt_x, pt_y)) {
         tri = -1;
     }
+    if (tri >= 0)
+        triangle_find_hint_set(pt_x, pt_y, tri);
     triangulation[0].last_tri = tri;
     return tri;
 #endif
@@ -367,6 +518,7 @@ void thin_wall(int x1, int y1, int x2, int y2, ubyte en1, ubyte en2)
       "call ASM_thin_wall\n"
         : : "a" (x1), "d" (y1), "b" (x2), "c" (y2), "g" (en1), "g" (en2));
 #else
+    triangle_route_cache_clear();
     thin_wall_x1 = x1;
     thin_wall_y1 = y1;
     thin_wall_x2 = x2;
@@ -719,6 +871,7 @@ void tri_set_rectangle(int x1, int y1, int x2, int y2, ubyte solid)
 #else
     int sx1, sy1, sx2, sy2;
 
+    triangle_route_cache_clear();
     sx1 = x1;
     sy1 = y1;
     sx2 = x2;
@@ -821,6 +974,8 @@ void triangulation_init(void)
     triangulation[0].point_top = triangulation[0].max_Points;
     triangulation_initxy(dim_lo, dim_lo, dim_hi, dim_hi);
     triangulation[0].last_tri = -1;
+    triangle_find_hints_clear();
+    triangle_route_cache_clear();
 }
 
 void triangulation_init_edges(void)
@@ -901,6 +1056,7 @@ void init_col_vects_linked_list(void)
 
     link__MapColListEmptyHead = 0;
     link__MapColVectEmptyHead = 0;
+    thing_sight_memo_clear();
 
     // TODO why this amount?
     limit = 1000;//get_memory_ptr_allocated_count((void **)&game_col_vects_list);
@@ -2033,11 +2189,216 @@ void generate_thin_paths(void)
     LbMemoryFree(faces4_added);
 }
 
+/** Checks whether there is no collision vector along given triangulation edge.
+ */
+static TbBool tri_edge_has_no_col_vect(int x1, int y1, int x2, int y2)
+{
+    struct MyMapElement *p_mapel;
+    struct ColVectList *p_cvlist;
+    int tile_x, tile_z;
+    ushort vl;
+    int n;
+
+    tile_x = MAPCOORD_TO_TILE(x1);
+    tile_z = MAPCOORD_TO_TILE(y1);
+    if ((tile_x < 0) || (tile_x >= MAP_TILE_WIDTH))
+        return false;
+    if ((tile_z < 0) || (tile_z >= MAP_TILE_HEIGHT))
+        return false;
+    p_mapel = &game_my_big_map[MAP_TILE_WIDTH * tile_z + tile_x];
+
+    n = 0;
+    for (vl = p_mapel->ColHead; vl != 0; vl = p_cvlist->NextColList & 0x7FFF)
+    {
+        struct ColVect *p_colvect;
+
+        if (n++ >= 200)
+            break;
+        p_cvlist = &game_col_vects_list[vl];
+        p_colvect = &game_col_vects[p_cvlist->Vect];
+
+        if ((abs(p_colvect->X1 - x1) < 32) && (abs(p_colvect->X2 - x2) < 32) &&
+          (abs(p_colvect->Z2 - y2) < 32) && (abs(p_colvect->Z1 - y1) < 32))
+            return false;
+        if ((abs(p_colvect->X1 - x2) < 32) && (abs(p_colvect->X2 - x1) < 32) &&
+          (abs(p_colvect->Z2 - y1) < 32) && (abs(p_colvect->Z1 - y2) < 32))
+            return false;
+    }
+    return true;
+}
+
+/** Allows moving through edges of given triangle which lie within given area
+ * and are not walls anymore.
+ */
+static void triangle_enter_free_edges_in_area(TrTriangId tri,
+  TrCoord x1, TrCoord y1, TrCoord x2, TrCoord y2)
+{
+    struct TrTriangle *p_tri;
+    ubyte inside;
+    int cor;
+
+    p_tri = &triangulation[0].Triangles[tri];
+    if ((p_tri->solid & 0x06) != 0)
+        return;
+
+    inside = 0;
+    for (cor = 0; cor < 3; cor++)
+    {
+        struct TrPoint *p_pt;
+
+        p_pt = &triangulation[0].Points[p_tri->point[cor]];
+        if ((p_pt->x >= x1) && (p_pt->x <= x2) && (p_pt->y >= y1) && (p_pt->y <= y2))
+            inside |= (1 << cor);
+    }
+
+    for (cor = 0; cor < 3; cor++)
+    {
+        struct TrPoint *p_pt1;
+        struct TrPoint *p_pt2;
+        struct TrTriangle *p_tri_nx;
+        TrTriangId tri_nx;
+        int cor1, cor_nx;
+
+        cor1 = MOD3[cor+1];
+        if (((inside & (1 << cor)) == 0) || ((inside & (1 << cor1)) == 0))
+            continue;
+        if ((p_tri->enter & (1 << cor)) != 0)
+            continue;
+        p_pt1 = &triangulation[0].Points[p_tri->point[cor]];
+        p_pt2 = &triangulation[0].Points[p_tri->point[cor1]];
+        if (!tri_edge_has_no_col_vect(p_pt1->x, p_pt1->y, p_pt2->x, p_pt2->y))
+            continue;
+        tri_nx = p_tri->tri[cor];
+        if (tri_nx < 0)
+            continue;
+        p_tri_nx = &triangulation[0].Triangles[tri_nx];
+        if ((p_tri_nx->solid & 0x06) != 0)
+            continue;
+
+        p_tri->enter |= (1 << cor);
+        for (cor_nx = 0; cor_nx < 3; cor_nx++)
+        {
+            if (p_tri_nx->tri[cor_nx] == tri) {
+                p_tri_nx->enter |= (1 << cor_nx);
+                break;
+            }
+        }
+    }
+}
+
+/** Checks whether bounding box of given triangle overlaps given area.
+ */
+static TbBool triangle_bbox_overlaps_area(TrTriangId tri,
+  TrCoord x1, TrCoord y1, TrCoord x2, TrCoord y2)
+{
+    struct TrTriangle *p_tri;
+    TrCoord tx1, ty1, tx2, ty2;
+    int cor;
+
+    p_tri = &triangulation[0].Triangles[tri];
+    tx1 = ty1 = INT_MAX;
+    tx2 = ty2 = INT_MIN;
+    for (cor = 0; cor < 3; cor++)
+    {
+        struct TrPoint *p_pt;
+
+        p_pt = &triangulation[0].Points[p_tri->point[cor]];
+        if (tx1 > p_pt->x) tx1 = p_pt->x;
+        if (tx2 < p_pt->x) tx2 = p_pt->x;
+        if (ty1 > p_pt->y) ty1 = p_pt->y;
+        if (ty2 < p_pt->y) ty2 = p_pt->y;
+    }
+    return (tx1 <= x2) && (tx2 >= x1) && (ty1 <= y2) && (ty2 >= y1);
+}
+
+/** Visits triangles overlapping given area, starting from the one at its center.
+ *
+ * Triangles overlapping a rectangle are connected, so walking through
+ * neighbours reaches all of them without checking the whole triangulation.
+ *
+ * @return True if the area was processed, false if it has to be done by
+ *  checking all triangles.
+ */
+static TbBool triangulation_area_enter_free_edges_local(TrCoord x1, TrCoord y1,
+  TrCoord x2, TrCoord y2)
+{
+    ubyte *visited;
+    TrTriangId *queue;
+    int queue_beg, queue_end;
+    int tri;
+
+    tri = triangle_find8(((x1 + x2) / 2) << 8, ((y1 + y2) / 2) << 8);
+    if (tri < 0)
+        return false;
+
+    visited = LbMemoryAlloc((triangulation[0].ix_Triangles + 7) / 8);
+    queue = LbMemoryAlloc(triangulation[0].ix_Triangles * sizeof(TrTriangId));
+    if ((visited == NULL) || (queue == NULL)) {
+        LbMemoryFree(visited);
+        LbMemoryFree(queue);
+        return false;
+    }
+    LbMemorySet(visited, 0, (triangulation[0].ix_Triangles + 7) / 8);
+
+    queue_beg = 0;
+    queue_end = 0;
+    visited[tri >> 3] |= (1 << (tri & 7));
+    queue[queue_end++] = tri;
+    while (queue_beg < queue_end)
+    {
+        struct TrTriangle *p_tri;
+        int cor;
+
+        tri = queue[queue_beg++];
+        triangle_enter_free_edges_in_area(tri, x1, y1, x2, y2);
+
+        p_tri = &triangulation[0].Triangles[tri];
+        for (cor = 0; cor < 3; cor++)
+        {
+            TrTriangId tri_nx;
+
+            tri_nx = p_tri->tri[cor];
+            if ((tri_nx < 0) || (tri_nx >= triangulation[0].ix_Triangles))
+                continue;
+            if ((visited[tri_nx >> 3] & (1 << (tri_nx & 7))) != 0)
+                continue;
+            visited[tri_nx >> 3] |= (1 << (tri_nx & 7));
+            if (!triangle_bbox_overlaps_area(tri_nx, x1, y1, x2, y2))
+                continue;
+            queue[queue_end++] = tri_nx;
+        }
+    }
+
+    LbMemoryFree(visited);
+    LbMemoryFree(queue);
+    return true;
+}
+
 void triangulation_unkn_func_002(int x1, int z1, int x2, int z2)
 {
+#if 0
     asm volatile (
       "call ASM_triangulation_unkn_func_002\n"
         : : "a" (x1), "d" (z1), "b" (x2), "c" (z2));
+#else
+    TrCoord ax1, ay1, ax2, ay2;
+
+    ax1 = x1 << 8;
+    ay1 = z1 << 8;
+    ax2 = (x2 + 1) << 8;
+    ay2 = (z2 + 1) << 8;
+
+    // Enter flags are changing, so cached routes may no longer be valid
+    triangle_route_cache_clear();
+
+    if (!triangulation_area_enter_free_edges_local(ax1, ay1, ax2, ay2))
+    {
+        TrTriangId tri;
+
+        for (tri = 0; tri < triangulation[0].ix_Triangles; tri++)
+            triangle_enter_free_edges_in_area(tri, ax1, ay1, ax2, ay2);
+    }
+#endif
 }
 
 int fringe_at_tile(short tile_x, short tile_z)
@@ -45,8 +45,19 @@ void generate_ground_map(void);
 void thin_wall_around_object_rm(ushort obj, ushort colt);
 void generate_map_triangulation(void);
 
+/** Restores moving between triangles within given tiles rectangle, through
+ * edges which are no longer walls; used after a building was destroyed.
+ *
+ * Only triangles around the rectangle are visited.
+ */
 void triangulation_unkn_func_002(int x1, int z1, int x2, int z2);
 
+/** Finds route of triangles between given ones, using routes cache if possible.
+ *
+ * @return Index of last triangle in route, or -1 if there is no route.
+ */
+int ma_triangle_route_3(int tri_beg, int tri_end, int *route, int *cost);
+
 /** Print triangulation arrays into log file, for debug.
  */
 void print_triangulation(void);
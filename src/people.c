@@ -55,6 +55,7 @@
 #include "thing_fire.h"
 #include "thing_onface.h"
 #include "thing_search.h"
+#include "thing_sight.h"
 #include "tngcolisn.h"
 #include "vehicle.h"
 #include "weapon.h"
@@ -1302,8 +1303,31 @@ void set_person_animmode_walk(struct Thing *p_person)
 int can_i_see_thing(struct Thing *p_me, struct Thing *p_him, int max_dist, ushort flags)
 {
     int ret;
+    TbBool use_memo;
+
+    // Debug drawing of the sight line needs the line to be traced
+    use_memo = (p_me != NULL) && (p_him != NULL) &&
+      !debug_hud_collision && !byte_1C844F;
+
+    if (use_memo && thing_sight_memo_get(p_me, p_him, max_dist, flags, &ret))
+    {
+        // Tracing turns the person towards visible target; do the same
+        if ((flags == 1) && (ret != 0))
+        {
+            short angle;
+
+            angle = arctan((p_him->X - p_me->X) >> 8, -((p_him->Z - p_me->Z) >> 8));
+            if ((angle >> 8) != p_me->U.UPerson.Angle)
+                change_person_angle(p_me, ((angle + 0x80) & 0x7FF) >> 8);
+        }
+        return ret;
+    }
+
     asm volatile ("call ASM_can_i_see_thing\n"
         : "=r" (ret) : "a" (p_me), "d" (p_him), "b" (max_dist), "c" (flags));
+
+    if (use_memo)
+        thing_sight_memo_put(p_me, p_him, max_dist, flags, ret);
     return ret;
 }
 
@@ -6070,6 +6094,8 @@ short person_hit_razor_wire(struct Thing *p_person, ThingIdx thing)
     asm volatile (
       "call ASM_person_hit_razor_wire\n"
         : "=r" (ret) : "a" (p_person), "d" (thing));
+    // The wire may have been snapped, deleting its collision vector
+    thing_sight_memo_clear();
     return ret;
 }
 
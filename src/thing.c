@@ -33,12 +33,14 @@
 #include "display.h"
 #include "engindrwlstx.h"
 #include "enginfexpl.h"
+#include "enginlights.h"
 #include "enginsngobjs.h"
 #include "enginsngtxtr.h"
 #include "frame_sprani.h"
 #include "game.h"
 #include "game_data.h"
 #include "game_options.h"
+#include "game_prof.h"
 #include "game_speed.h"
 #include "matrix.h"
 #include "packet.h"
@@ -46,6 +48,8 @@
 #include "player.h"
 #include "sound.h"
 #include "thing_fire.h"
+#include "thing_grid.h"
+#include "trroute.h"
 #include "vehicle.h"
 #include "game.h"
 #include "swlog.h"
@@ -302,9 +306,24 @@ ubyte on_mapwho(struct Thing *p_thing)
 
 void move_mapwho(struct Thing *p_thing, int x, int y, int z)
 {
+    short prev_tile_x, prev_tile_z;
+
+    prev_tile_x = MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->X));
+    prev_tile_z = MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->Z));
     asm volatile (
       "call ASM_move_mapwho\n"
         : : "a" (p_thing), "d" (x), "b" (y), "c" (z));
+    // The call unlinks the thing through delete_node(), but links it back
+    // to the new tile internally; that part has to be noted in the grid
+    if ((p_thing->Flag2 & TgF2_ExistsOffMap) != 0)
+        return;
+    if ((x < 0) || (PRCCOORD_TO_MAPCOORD(x) >= MAP_COORD_WIDTH))
+        return;
+    if ((z < 0) || (PRCCOORD_TO_MAPCOORD(z) >= MAP_COORD_HEIGHT))
+        return;
+    if ((MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->X)) != prev_tile_x) ||
+      (MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->Z)) != prev_tile_z))
+        thing_grid_thing_linked(p_thing->ThingOffset);
 }
 
 void init_just_things(void)
@@ -341,6 +360,8 @@ void quick_light_unkn_func_04(short a1, int a2, short a3, short a4)
     asm volatile (
       "call ASM_quick_light_unkn_func_04\n"
         : : "a" (a1), "d" (a2), "b" (a3), "c" (a4));
+    // Removes quick lights from chains
+    quick_lights_shade_cache_invalidate();
     return;
 }
 
@@ -363,6 +384,8 @@ void apply_full_light(short lx, short lz, ushort b, ushort intens, ushort lid)
       "push %4\n"
       "call ASM_apply_full_light\n"
         : : "a" (lx), "d" (lz), "b" (b), "c" (intens), "g" (lid));
+    // Adds quick lights to chains
+    quick_lights_shade_cache_invalidate();
     return;
 }
 
@@ -1134,6 +1157,11 @@ void process_things(void)
     int i;
     ushort plyr;
 
+    // Re-sync the grid, in case anything relinked things bypassing the hooks
+    thing_grid_rebuild();
+    // Cached routes are not saved, so they cannot outlive a game turn
+    triangle_route_cache_clear();
+
     for (plyr = 0; plyr < PLAYERS_LIMIT; plyr++)
     {
         PlayerInfo *p_player;
@@ -1196,12 +1224,23 @@ void process_things(void)
       && ((ingame.Flags & GamF_Unkn0004) != 0) && ((gameturn & 0xF) != 0))
         return;
 
+    // Things have to be processed one by one, in list order. Processing
+    // routines draw from the shared random generator, relink mapwho, spawn
+    // and remove things, and the ones still in assembly keep their temporary
+    // values in static variables. Any reordering would break replays and
+    // network game sync.
+    //TODO splitting this into parallel compute and serial commit phases is
+    // blocked until process_person(), process_spark() and the other handlers
+    // are ported to C. Even the simple things already in C are not
+    // independent: process_temp_light() draws from lbSeed and writes the
+    // shared light map, process_static() plays sounds.
     if (execute_commands)
     {
         struct Thing *p_thing;
         int remain;
         ThingIdx thing, nxthing;
 
+        frame_prof_begin(FPrPh_THINGS);
         remain = things_used;
         for (thing = things_used_head; thing > 0; thing = nxthing)
         {
@@ -1221,6 +1260,7 @@ void process_things(void)
 
             process_thing(p_thing, thing);
         }
+        frame_prof_end(FPrPh_THINGS);
     }
 
     if (execute_commands)
@@ -1229,6 +1269,7 @@ void process_things(void)
         int remain;
         ThingIdx thing, nxthing;
 
+        frame_prof_begin(FPrPh_STHINGS);
         remain = sthings_used;
         for (thing = sthings_used_head; thing < 0; thing = nxthing)
         {
@@ -1242,11 +1283,14 @@ void process_things(void)
 
             process_sthing(p_sthing, thing);
         }
+        frame_prof_end(FPrPh_STHINGS);
     }
 
     if (execute_commands)
     {
+        frame_prof_begin(FPrPh_PEOPLE_INTEL);
         people_intel(0);
+        frame_prof_end(FPrPh_PEOPLE_INTEL);
     }
     navi_onscreen_debug(1);
 }
@@ -1364,6 +1408,7 @@ TbBool thing_is_pickup_item(ThingIdx thing)
 TbResult delete_node(struct Thing *p_thing)
 {
     TbResult ret;
+    thing_grid_thing_unlinked(p_thing->ThingOffset);
     asm volatile ("call ASM_delete_node\n"
         : "=r" (ret) : "a" (p_thing));
     return ret;
@@ -1381,6 +1426,7 @@ void add_node_thing(ThingIdx new_thing)
 {
     asm volatile ("call ASM_add_node_thing\n"
         : : "a" (new_thing));
+    thing_grid_thing_linked(new_thing);
 }
 
 short get_new_thing(void)
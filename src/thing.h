@@ -255,7 +255,7 @@ struct TngUObject
     short tnode[4];  /**< Thing offs=0x90 */
     ubyte player_in_me;
     ubyte unkn_4D;
-    ulong DrawTurn; // set within draw_thing_object() for a building
+    ulong DrawTurn; // set to render_frame within draw_thing_object() for a building
     short tnode_50[4];
 };
 
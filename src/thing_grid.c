@@ -0,0 +1,208 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_grid.c
+ *     Coarse grid of thing counts, used to speed up radius searches.
+ * @par Purpose:
+ *     Keeps amount of things of the most searched types within each cell
+ *     of a coarse grid over mapwho tiles. Searches walking the mapwho spiral
+ *     can then skip tiles within cells which have no thing of requested type.
+ * @par Comment:
+ *     The grid only prunes tiles which surely have nothing to find; order
+ *     of the search is unchanged, so the results are identical to a search
+ *     without the grid. This is required to keep replays deterministic.
+ *     Simple things are not counted, as some of their moves are done within
+ *     assembly code and bypass the hooks.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "thing_grid.h"
+
+#include "bfmemut.h"
+
+#include "bigmap.h"
+#include "thing.h"
+#include "swlog.h"
+/******************************************************************************/
+
+/** Types of things counted by the grid.
+ *
+ * Only types which are not given to things already linked to mapwho can be
+ * tracked, as type change does not go through the grid. A thing leaving
+ * tracked type while linked only makes the counts too high, which is safe.
+ */
+enum ThingGridTypes {
+    TGrT_NONE = 0,
+    TGrT_PERSON,
+    TGrT_VEHICLE,
+    TGrT_BUILDING,
+    TGrT_COUNT,
+};
+
+#define THING_GRID_CELLS (THING_GRID_WIDTH * THING_GRID_HEIGHT)
+
+/** Grid cell to which each thing was counted, or -1 if not counted. */
+static short thing_cell[THINGS_LIMIT];
+/** Grid type to which each thing was counted. */
+static ubyte thing_grtype[THINGS_LIMIT];
+
+static ushort cell_type_count[TGrT_COUNT][THING_GRID_CELLS];
+static ushort map_type_count[TGrT_COUNT];
+
+static TbBool thing_grid_valid = false;
+
+/******************************************************************************/
+
+static ubyte thing_type_to_grid_type(short ttype)
+{
+    switch (ttype)
+    {
+    case TT_PERSON:
+        return TGrT_PERSON;
+    case TT_VEHICLE:
+        return TGrT_VEHICLE;
+    case TT_BUILDING:
+        return TGrT_BUILDING;
+    default:
+        return TGrT_NONE;
+    }
+}
+
+static short tile_to_grid_cell(short tile_x, short tile_z)
+{
+    if ((tile_x < 0) || (tile_x >= MAP_TILE_WIDTH))
+        return -1;
+    if ((tile_z < 0) || (tile_z >= MAP_TILE_HEIGHT))
+        return -1;
+    return (tile_z >> THING_GRID_CELL_SHIFT) * THING_GRID_WIDTH +
+      (tile_x >> THING_GRID_CELL_SHIFT);
+}
+
+static void thing_grid_count_thing(ThingIdx thing, short cell)
+{
+    struct Thing *p_thing;
+    ubyte grtype;
+
+    p_thing = &things[thing];
+    grtype = thing_type_to_grid_type(p_thing->Type);
+    thing_cell[thing] = cell;
+    thing_grtype[thing] = grtype;
+    cell_type_count[grtype][cell]++;
+    map_type_count[grtype]++;
+}
+
+void thing_grid_invalidate(void)
+{
+    thing_grid_valid = false;
+}
+
+void thing_grid_rebuild(void)
+{
+    short tile_x, tile_z;
+    ThingIdx thing;
+
+    LbMemorySet(cell_type_count, 0, sizeof(cell_type_count));
+    LbMemorySet(map_type_count, 0, sizeof(map_type_count));
+    for (thing = 0; thing < THINGS_LIMIT; thing++)
+        thing_cell[thing] = -1;
+
+    for (tile_z = 0; tile_z < MAP_TILE_HEIGHT; tile_z++)
+    {
+        for (tile_x = 0; tile_x < MAP_TILE_WIDTH; tile_x++)
+        {
+            short cell;
+            ulong k;
+
+            cell = tile_to_grid_cell(tile_x, tile_z);
+            k = 0;
+            thing = get_mapwho_thing_index(tile_x, tile_z);
+            while (thing != 0)
+            {
+                if (thing < 0) {
+                    thing = sthings[thing].Next;
+                } else {
+                    if (thing < THINGS_LIMIT)
+                        thing_grid_count_thing(thing, cell);
+                    thing = things[thing].Next;
+                }
+                k++;
+                if (k >= STHINGS_LIMIT+THINGS_LIMIT) {
+                    LOGERR("Infinite loop in mapwho things list");
+                    break;
+                }
+            }
+        }
+    }
+    thing_grid_valid = true;
+}
+
+void thing_grid_thing_linked(ThingIdx thing)
+{
+    struct Thing *p_thing;
+    short cell;
+
+    if (!thing_grid_valid || (thing <= 0) || (thing >= THINGS_LIMIT))
+        return;
+    if (thing_cell[thing] >= 0)
+        thing_grid_thing_unlinked(thing);
+    p_thing = &things[thing];
+    cell = tile_to_grid_cell(MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->X)),
+      MAPCOORD_TO_TILE(PRCCOORD_TO_MAPCOORD(p_thing->Z)));
+    if (cell < 0)
+        return;
+    thing_grid_count_thing(thing, cell);
+}
+
+void thing_grid_thing_unlinked(ThingIdx thing)
+{
+    short cell;
+    ubyte grtype;
+
+    if (!thing_grid_valid || (thing <= 0) || (thing >= THINGS_LIMIT))
+        return;
+    cell = thing_cell[thing];
+    if (cell < 0)
+        return;
+    grtype = thing_grtype[thing];
+    cell_type_count[grtype][cell]--;
+    map_type_count[grtype]--;
+    thing_cell[thing] = -1;
+}
+
+TbBool thing_grid_type_is_tracked(short ttype)
+{
+    return (thing_type_to_grid_type(ttype) != TGrT_NONE);
+}
+
+TbBool thing_grid_tile_may_have_type(short tile_x, short tile_z, short ttype)
+{
+    ubyte grtype;
+    short cell;
+
+    grtype = thing_type_to_grid_type(ttype);
+    if (!thing_grid_valid || (grtype == TGrT_NONE))
+        return true;
+    cell = tile_to_grid_cell(tile_x, tile_z);
+    // Tiles outside of the map have no things
+    if (cell < 0)
+        return false;
+    return (cell_type_count[grtype][cell] != 0);
+}
+
+TbBool thing_grid_map_may_have_type(short ttype)
+{
+    ubyte grtype;
+
+    grtype = thing_type_to_grid_type(ttype);
+    if (!thing_grid_valid || (grtype == TGrT_NONE))
+        return true;
+    return (map_type_count[grtype] != 0);
+}
+
+/******************************************************************************/
@@ -0,0 +1,77 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_grid.h
+ *     Header file for thing_grid.c.
+ * @par Purpose:
+ *     Coarse grid of thing counts, used to speed up radius searches.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef THING_GRID_H
+#define THING_GRID_H
+
+#include "bftypes.h"
+#include "game_bstype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Bits of shift converting map tile into grid cell; cell is 4x4 tiles.
+ */
+#define THING_GRID_CELL_SHIFT 2
+
+#define THING_GRID_WIDTH  (128 >> THING_GRID_CELL_SHIFT)
+#define THING_GRID_HEIGHT (128 >> THING_GRID_CELL_SHIFT)
+
+struct Thing;
+
+/******************************************************************************/
+
+/** Marks the grid as out of sync with mapwho; searches will not use it
+ * until the next rebuild.
+ */
+void thing_grid_invalidate(void);
+
+/** Recomputes the grid from things linked to mapwho tiles.
+ */
+void thing_grid_rebuild(void);
+
+/** Updates the grid after a thing was linked to mapwho tile.
+ */
+void thing_grid_thing_linked(ThingIdx thing);
+
+/** Updates the grid after a thing was unlinked from mapwho.
+ */
+void thing_grid_thing_unlinked(ThingIdx thing);
+
+/** Returns whether given thing type is counted by the grid.
+ * Searches for other types cannot be narrowed down with the grid.
+ */
+TbBool thing_grid_type_is_tracked(short ttype);
+
+/** Returns whether the given mapwho tile may contain a thing of given type.
+ * Only valid for types tracked by the grid; false positives are possible,
+ * but if this returns false, the tile surely has no thing of that type.
+ */
+TbBool thing_grid_tile_may_have_type(short tile_x, short tile_z, short ttype);
+
+/** Returns whether there may be any thing of given type on mapwho.
+ */
+TbBool thing_grid_map_may_have_type(short ttype);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,271 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_interp.c
+ *     Interpolation of things and camera positions for frames between turns.
+ * @par Purpose:
+ *     Allows drawing frames between game turns, with things placed between
+ *     their previous and current position. The drawing code reads positions
+ *     directly from things, so the interpolated positions are swapped in
+ *     before drawing, and the real ones are brought back afterwards.
+ * @par Comment:
+ *     Things are drawn from mapwho tile of their real position; this does not
+ *     matter for drawing, as the interpolated position is always near.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "thing_interp.h"
+
+#include <stdlib.h>
+#include "bfmemut.h"
+
+#include "bigmap.h"
+#include "engincam.h"
+#include "thing.h"
+#include "swlog.h"
+/******************************************************************************/
+
+struct InterpPos {
+    s32 X;
+    s32 Y;
+    s32 Z;
+    ubyte Type;
+    ubyte Valid;
+};
+
+struct InterpCamera {
+    s32 X;
+    s32 Y;
+    s32 Z;
+    s32 AngleXZ;
+};
+
+/** Positions of things in previous turn, indexed by thing. */
+static struct InterpPos things_prev_pos[THINGS_LIMIT];
+/** Positions of simple things in previous turn, indexed by negated thing. */
+static struct InterpPos sthings_prev_pos[STHINGS_LIMIT+1];
+
+/** Real positions of things replaced by the interpolated ones. */
+static struct InterpPos replaced_pos[THINGS_LIMIT+STHINGS_LIMIT];
+static ThingIdx replaced_thing[THINGS_LIMIT+STHINGS_LIMIT];
+static ushort replaced_count = 0;
+
+static struct InterpCamera cam_prev;
+static struct InterpCamera cam_curr;
+static struct InterpCamera cam_real;
+
+/******************************************************************************/
+
+void thing_interp_snapshot(void)
+{
+    ThingIdx thing;
+    int remain;
+
+    LbMemorySet(things_prev_pos, 0, sizeof(things_prev_pos));
+    LbMemorySet(sthings_prev_pos, 0, sizeof(sthings_prev_pos));
+
+    remain = things_used;
+    for (thing = things_used_head; thing > 0; thing = things[thing].LinkChild)
+    {
+        struct Thing *p_thing;
+        struct InterpPos *p_pos;
+
+        if (--remain == -1)
+            break;
+        if (thing >= THINGS_LIMIT)
+            continue;
+        p_thing = &things[thing];
+        p_pos = &things_prev_pos[thing];
+        p_pos->X = p_thing->X;
+        p_pos->Y = p_thing->Y;
+        p_pos->Z = p_thing->Z;
+        p_pos->Type = p_thing->Type;
+        p_pos->Valid = true;
+    }
+
+    remain = sthings_used;
+    for (thing = sthings_used_head; thing < 0; thing = sthings[thing].LinkChild)
+    {
+        struct SimpleThing *p_sthing;
+        struct InterpPos *p_pos;
+
+        if (--remain == -1)
+            break;
+        if (-thing > STHINGS_LIMIT)
+            continue;
+        p_sthing = &sthings[thing];
+        p_pos = &sthings_prev_pos[-thing];
+        p_pos->X = p_sthing->X;
+        p_pos->Y = p_sthing->Y;
+        p_pos->Z = p_sthing->Z;
+        p_pos->Type = p_sthing->Type;
+        p_pos->Valid = true;
+    }
+}
+
+void thing_interp_camera_store(void)
+{
+    cam_prev = cam_curr;
+    cam_curr.X = engn_xc;
+    cam_curr.Y = engn_yc;
+    cam_curr.Z = engn_zc;
+    cam_curr.AngleXZ = engn_anglexz;
+}
+
+static s32 interp_coord(s32 prev, s32 curr, ushort fraction)
+{
+    return prev + (s32)(((s64)(curr - prev) * fraction) >> 8);
+}
+
+/** Interpolates position of one thing; returns false if it should stay intact.
+ */
+static TbBool interp_position(s32 *p_x, s32 *p_y, s32 *p_z,
+  const struct InterpPos *p_prev, ubyte tngtype, ushort fraction)
+{
+    s32 dist_x, dist_z;
+
+    if (!p_prev->Valid || (p_prev->Type != tngtype))
+        return false;
+    if ((p_prev->X == *p_x) && (p_prev->Y == *p_y) && (p_prev->Z == *p_z))
+        return false;
+    dist_x = PRCCOORD_TO_MAPCOORD(abs(*p_x - p_prev->X));
+    dist_z = PRCCOORD_TO_MAPCOORD(abs(*p_z - p_prev->Z));
+    if ((dist_x > THING_INTERP_MAX_DIST) || (dist_z > THING_INTERP_MAX_DIST))
+        return false;
+
+    *p_x = interp_coord(p_prev->X, *p_x, fraction);
+    *p_y = interp_coord(p_prev->Y, *p_y, fraction);
+    *p_z = interp_coord(p_prev->Z, *p_z, fraction);
+    return true;
+}
+
+static void thing_interp_camera_apply(ushort fraction)
+{
+    s32 delta;
+
+    cam_real.X = engn_xc;
+    cam_real.Y = engn_yc;
+    cam_real.Z = engn_zc;
+    cam_real.AngleXZ = engn_anglexz;
+
+    // The next camera position is not known yet; extrapolate from the last move
+    delta = cam_curr.X - cam_prev.X;
+    if (abs(delta) < THING_INTERP_MAX_DIST)
+        engn_xc = cam_curr.X + ((delta * fraction) >> 8);
+    delta = cam_curr.Y - cam_prev.Y;
+    if (abs(delta) < THING_INTERP_MAX_DIST)
+        engn_yc = cam_curr.Y + ((delta * fraction) >> 8);
+    delta = cam_curr.Z - cam_prev.Z;
+    if (abs(delta) < THING_INTERP_MAX_DIST)
+        engn_zc = cam_curr.Z + ((delta * fraction) >> 8);
+    // Angle is stored shifted by 5; make sure the delta wraps correctly
+    delta = (short)((cam_curr.AngleXZ - cam_prev.AngleXZ) & 0xFFFF);
+    engn_anglexz = cam_curr.AngleXZ + ((delta * fraction) >> 8);
+}
+
+void thing_interp_apply(ushort fraction)
+{
+    ThingIdx thing;
+    int remain;
+
+    replaced_count = 0;
+
+    remain = things_used;
+    for (thing = things_used_head; thing > 0; thing = things[thing].LinkChild)
+    {
+        struct Thing *p_thing;
+        struct InterpPos *p_repl;
+        s32 x, y, z;
+
+        if (--remain == -1)
+            break;
+        if (thing >= THINGS_LIMIT)
+            continue;
+        p_thing = &things[thing];
+        x = p_thing->X;
+        y = p_thing->Y;
+        z = p_thing->Z;
+        if (!interp_position(&x, &y, &z, &things_prev_pos[thing], p_thing->Type, fraction))
+            continue;
+        p_repl = &replaced_pos[replaced_count];
+        p_repl->X = p_thing->X;
+        p_repl->Y = p_thing->Y;
+        p_repl->Z = p_thing->Z;
+        replaced_thing[replaced_count] = thing;
+        replaced_count++;
+        p_thing->X = x;
+        p_thing->Y = y;
+        p_thing->Z = z;
+    }
+
+    remain = sthings_used;
+    for (thing = sthings_used_head; thing < 0; thing = sthings[thing].LinkChild)
+    {
+        struct SimpleThing *p_sthing;
+        struct InterpPos *p_repl;
+        s32 x, y, z;
+
+        if (--remain == -1)
+            break;
+        if (-thing > STHINGS_LIMIT)
+            continue;
+        p_sthing = &sthings[thing];
+        x = p_sthing->X;
+        y = p_sthing->Y;
+        z = p_sthing->Z;
+        if (!interp_position(&x, &y, &z, &sthings_prev_pos[-thing], p_sthing->Type, fraction))
+            continue;
+        p_repl = &replaced_pos[replaced_count];
+        p_repl->X = p_sthing->X;
+        p_repl->Y = p_sthing->Y;
+        p_repl->Z = p_sthing->Z;
+        replaced_thing[replaced_count] = thing;
+        replaced_count++;
+        p_sthing->X = x;
+        p_sthing->Y = y;
+        p_sthing->Z = z;
+    }
+
+    thing_interp_camera_apply(fraction);
+}
+
+void thing_interp_restore(void)
+{
+    ushort i;
+
+    for (i = 0; i < replaced_count; i++)
+    {
+        ThingIdx thing;
+        struct InterpPos *p_repl;
+
+        thing = replaced_thing[i];
+        p_repl = &replaced_pos[i];
+        if (thing > 0) {
+            struct Thing *p_thing;
+            p_thing = &things[thing];
+            p_thing->X = p_repl->X;
+            p_thing->Y = p_repl->Y;
+            p_thing->Z = p_repl->Z;
+        } else {
+            struct SimpleThing *p_sthing;
+            p_sthing = &sthings[thing];
+            p_sthing->X = p_repl->X;
+            p_sthing->Y = p_repl->Y;
+            p_sthing->Z = p_repl->Z;
+        }
+    }
+    replaced_count = 0;
+
+    engn_xc = cam_real.X;
+    engn_yc = cam_real.Y;
+    engn_zc = cam_real.Z;
+    engn_anglexz = cam_real.AngleXZ;
+}
+
+/******************************************************************************/
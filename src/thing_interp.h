@@ -0,0 +1,62 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_interp.h
+ *     Header file for thing_interp.c.
+ * @par Purpose:
+ *     Interpolation of things and camera positions for frames between turns.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef THING_INTERP_H
+#define THING_INTERP_H
+
+#include "bftypes.h"
+#include "game_bstype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Max distance a thing can move within one turn and still be interpolated.
+ * Longer moves are treated as teleports, and drawn at target position.
+ */
+#define THING_INTERP_MAX_DIST (4 * 256)
+
+/******************************************************************************/
+
+/** Stores positions of all things, as state of the previous turn.
+ * To be called just before things are processed.
+ */
+void thing_interp_snapshot(void);
+
+/** Stores camera position used for drawing the current turn.
+ * To be called after the normal frame of a turn is drawn.
+ */
+void thing_interp_camera_store(void);
+
+/** Temporarily replaces positions of things and camera with interpolated ones.
+ *
+ * @param fraction Progress between the previous and current turn state,
+ *     in range 0..256.
+ */
+void thing_interp_apply(ushort fraction);
+
+/** Brings back the real positions replaced by thing_interp_apply().
+ */
+void thing_interp_restore(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
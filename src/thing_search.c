@@ -27,6 +27,7 @@
 #include "swlog.h"
 #include "thing.h"
 #include "thing_fire.h"
+#include "thing_grid.h"
 #include "vehicle.h"
 #include "weapon.h"
 
@@ -166,6 +167,8 @@ static ThingIdx find_thing_type_on_spiral_near_tile_with_bfilter(short X, short
     short tile_x, tile_z;
     int around;
 
+    if (!thing_grid_map_may_have_type(ttype))
+        return 0;
     tile_x = MAPCOORD_TO_TILE(X);
     tile_z = MAPCOORD_TO_TILE(Z);
     for (around = 0; around < spiral_len; around++)
@@ -177,6 +180,9 @@ static ThingIdx find_thing_type_on_spiral_near_tile_with_bfilter(short X, short
         sstep = &spiral_step[around];
         sX = tile_x + sstep->h;
         sZ = tile_z + sstep->v;
+        // Skipping tiles does not alter order of the search, so the result is the same
+        if (!thing_grid_tile_may_have_type(sX, sZ, ttype))
+            continue;
         thing = find_thing_on_mapwho_tile_within_circle_with_bfilter(sX, sZ, X, Z, R,
           ttype, subtype, filter, params);
         if (thing != 0)
@@ -238,6 +244,8 @@ static ThingIdx find_thing_type_on_spiral_near_tile_with_mfilter(short X, short
 
     min_fval = INT32_MAX;
     min_thing = 0;
+    if (!thing_grid_map_may_have_type(ttype))
+        return min_thing;
     tile_x = MAPCOORD_TO_TILE(X);
     tile_z = MAPCOORD_TO_TILE(Z);
     for (around = 0; around < spiral_len; around++)
@@ -250,6 +258,8 @@ static ThingIdx find_thing_type_on_spiral_near_tile_with_mfilter(short X, short
         sstep = &spiral_step[around];
         sX = tile_x + sstep->h;
         sZ = tile_z + sstep->v;
+        if (!thing_grid_tile_may_have_type(sX, sZ, ttype))
+            continue;
         thing = find_thing_on_mapwho_tile_within_circle_with_mfilter(&fval, sX, sZ, X, Z, R,
           ttype, subtype, filter, params);
         if (fval < min_fval) {
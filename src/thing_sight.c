@@ -0,0 +1,150 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_sight.c
+ *     Memory of line of sight checks between things within a game turn.
+ * @par Purpose:
+ *     Allows checks repeated for the same pair of things to skip tracing
+ *     the sight line through the map again.
+ * @par Comment:
+ *     Sight line tracing only reads positions and a few flags of the things,
+ *     and map collision data. All of these are part of the key, except
+ *     collision data, changes of which drop the whole memory.
+ *     Routines which modify collision vectors (game_col_vects_list) and so
+ *     need to call thing_sight_memo_clear():
+ *     - init_col_vects_linked_list(), and level setup adding object faces
+ *       through add_obj_face_to_col_vect() right after it;
+ *     - set_dome_col(), switching passability of building vectors;
+ *     - explode_thing_building() and collapse_building();
+ *     - do_shockwave(), which may call del_thing_vectors_from_mapwho();
+ *     - finalise_razor_wire(), which calls dynamic_insert_vect();
+ *     - person_hit_razor_wire() and snap_razor_wire(), calling delete_vect().
+ *     The asm routines reach these only through their C wrappers.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#include "thing_sight.h"
+
+#include "game_speed.h"
+#include "thing.h"
+/******************************************************************************/
+
+struct SightMemoEntry {
+    /** Memory generation in which the entry was stored; entry is valid only if it matches. */
+    ulong gen;
+    GameTurn turn;
+    struct Thing *p_me;
+    struct Thing *p_him;
+    long me_X, me_Y, me_Z;
+    long him_X, him_Y, him_Z;
+    ulong me_Flag;
+    ulong him_Flag;
+    ulong him_Flag2;
+    ubyte me_Type;
+    ubyte him_Type;
+    ubyte me_Angle;
+    ushort flags;
+    int max_dist;
+    int result;
+};
+
+static struct SightMemoEntry sight_memo[THING_SIGHT_MEMO_COUNT];
+
+/** Current memory generation; increasing it drops all entries at once.
+ * Starts at 1, as zeroed entries have generation 0.
+ */
+static ulong sight_memo_gen = 1;
+
+static struct SightMemoEntry *thing_sight_memo_entry(struct Thing *p_me, struct Thing *p_him)
+{
+    ulong hash;
+
+    hash = (ushort)p_me->ThingOffset * 67 + (ushort)p_him->ThingOffset;
+    return &sight_memo[hash % THING_SIGHT_MEMO_COUNT];
+}
+
+/** Checks whether the entry was stored for the same things and parameters.
+ */
+static TbBool thing_sight_memo_matches(struct SightMemoEntry *p_entry,
+  struct Thing *p_me, struct Thing *p_him, int max_dist, ushort flags)
+{
+    if ((p_entry->gen != sight_memo_gen) || (p_entry->turn != gameturn))
+        return false;
+    if ((p_entry->p_me != p_me) || (p_entry->p_him != p_him))
+        return false;
+    if ((p_entry->flags != flags) || (p_entry->max_dist != max_dist))
+        return false;
+    if ((p_entry->me_X != p_me->X) || (p_entry->me_Y != p_me->Y) || (p_entry->me_Z != p_me->Z))
+        return false;
+    if ((p_entry->him_X != p_him->X) || (p_entry->him_Y != p_him->Y) || (p_entry->him_Z != p_him->Z))
+        return false;
+    if ((p_entry->me_Type != p_me->Type) || (p_entry->him_Type != p_him->Type))
+        return false;
+    if ((p_entry->me_Flag != p_me->Flag) || (p_entry->him_Flag != p_him->Flag) ||
+      (p_entry->him_Flag2 != p_him->Flag2))
+        return false;
+    // Facing only matters if the check is limited to field of view
+    if (((flags & 0x01) == 0) && (p_entry->me_Angle != p_me->U.UPerson.Angle))
+        return false;
+    return true;
+}
+
+TbBool thing_sight_memo_get(struct Thing *p_me, struct Thing *p_him,
+  int max_dist, ushort flags, int *p_result)
+{
+    struct SightMemoEntry *p_entry;
+
+    p_entry = thing_sight_memo_entry(p_me, p_him);
+    if (!thing_sight_memo_matches(p_entry, p_me, p_him, max_dist, flags))
+        return false;
+    *p_result = p_entry->result;
+    return true;
+}
+
+void thing_sight_memo_put(struct Thing *p_me, struct Thing *p_him,
+  int max_dist, ushort flags, int result)
+{
+    struct SightMemoEntry *p_entry;
+
+    p_entry = thing_sight_memo_entry(p_me, p_him);
+    p_entry->gen = sight_memo_gen;
+    p_entry->turn = gameturn;
+    p_entry->p_me = p_me;
+    p_entry->p_him = p_him;
+    p_entry->me_X = p_me->X;
+    p_entry->me_Y = p_me->Y;
+    p_entry->me_Z = p_me->Z;
+    p_entry->him_X = p_him->X;
+    p_entry->him_Y = p_him->Y;
+    p_entry->him_Z = p_him->Z;
+    p_entry->me_Flag = p_me->Flag;
+    p_entry->him_Flag = p_him->Flag;
+    p_entry->him_Flag2 = p_him->Flag2;
+    p_entry->me_Type = p_me->Type;
+    p_entry->him_Type = p_him->Type;
+    p_entry->me_Angle = p_me->U.UPerson.Angle;
+    p_entry->flags = flags;
+    p_entry->max_dist = max_dist;
+    p_entry->result = result;
+}
+
+void thing_sight_memo_clear(void)
+{
+    int i;
+
+    sight_memo_gen++;
+    if (sight_memo_gen != 0)
+        return;
+    // On wrap-around, old entries could become valid again
+    for (i = 0; i < THING_SIGHT_MEMO_COUNT; i++)
+        sight_memo[i].gen = 0;
+    sight_memo_gen = 1;
+}
+
+/******************************************************************************/
@@ -0,0 +1,63 @@
+/******************************************************************************/
+// Syndicate Wars Fan Expansion, source port of the classic game from Bullfrog.
+/******************************************************************************/
+/** @file thing_sight.h
+ *     Header file for thing_sight.c.
+ * @par Purpose:
+ *     Memory of line of sight checks between things within a game turn.
+ * @par Comment:
+ *     Just a header file - #defines, typedefs, function prototypes etc.
+ * @author   Tomasz Lis
+ * @date     17 Oct 2026 - 17 Oct 2026
+ * @par  Copying and copyrights:
+ *     This program is free software; you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation; either version 2 of the License, or
+ *     (at your option) any later version.
+ */
+/******************************************************************************/
+#ifndef THING_SIGHT_H
+#define THING_SIGHT_H
+
+#include "bftypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************************************************************/
+
+/** Amount of sight check results remembered.
+ */
+#define THING_SIGHT_MEMO_COUNT 512
+
+struct Thing;
+
+/******************************************************************************/
+
+/** Gets remembered result of sight check between given things.
+ *
+ * Results are only reused within the game turn they were computed in,
+ * and only if positions of both things and the check parameters did not
+ * change since.
+ *
+ * @param p_result Output for the check result.
+ * @return True if the result was found, false if the check has to be made.
+ */
+TbBool thing_sight_memo_get(struct Thing *p_me, struct Thing *p_him,
+  int max_dist, ushort flags, int *p_result);
+
+/** Remembers result of sight check between given things.
+ */
+void thing_sight_memo_put(struct Thing *p_me, struct Thing *p_him,
+  int max_dist, ushort flags, int result);
+
+/** Forgets all remembered sight checks; to be called whenever collision
+ * vectors or columns change.
+ */
+void thing_sight_memo_clear(void);
+
+/******************************************************************************/
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -30,6 +30,7 @@
 #include "bigmap.h"
 #include "drawtext_wrp.h"
 #include "thing.h"
+#include "thing_sight.h"
 /******************************************************************************/
 
 ushort next_col_vect = 1;
@@ -45,6 +46,8 @@ void set_dome_col(struct Thing *p_building, ubyte flag)
     // which can switch the passability
     vl_beg = p_building->U.UObject.BuildStartVect;
     vl_end = vl_beg + p_building->U.UObject.BuildNumbVect;
+    // Passability of walls is changing, so remembered sight checks may be wrong
+    thing_sight_memo_clear();
     if (flag)
     {
         for (vl = vl_beg; vl < vl_end; vl++)
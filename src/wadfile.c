@@ -8,7 +8,7 @@
  * @par Comment:
  *     None.
  * @author   Tomasz Lis
- * @date     27 May 2022 - 19 Aug 2023
+ * @date     27 May 2022 - 17 Oct 2026
  * @par  Copying and copyrights:
  *     This program is free software; you can redistribute it and/or modify
  *     it under the terms of the GNU General Public License as published by
@@ -20,7 +20,14 @@
 
 #include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+# include <sys/mman.h>
+# define WADFILE_USE_MMAP 1
+#else
+# define WADFILE_USE_MMAP 0
+#endif
 #include "bftypes.h"
 
 #include "campaign.h"
@@ -29,6 +36,29 @@
 #include "swlog.h"
 /******************************************************************************/
 
+/** WAD archive kept open between lookups, with its whole index in memory.
+ */
+struct WadArchive {
+    /** Path to the archive, without extension; empty if the slot is unused. */
+    char Fname[DISKPATH_SIZE];
+    struct WADIndexEntry *Index;
+    ulong EntriesCount;
+    /** Open addressing table of index entries; stores entry number plus one. */
+    ulong *HashTable;
+    ulong HashSize;
+    TbFileHandle WadFh;
+    /** Contents of the WAD file mapped into memory, or NULL if not mapped. */
+    ubyte *MapData;
+    ulong MapSize;
+    ulong LastUse;
+};
+
+static struct WadArchive wad_archives[WAD_ARCHIVES_LIMIT] = {
+    [0 ... WAD_ARCHIVES_LIMIT-1] = {.WadFh = INVALID_FILE},
+};
+static ulong wad_archives_use_counter = 0;
+
+
 TbResult wadfile_format_entfile_name(char *entfile, const char *filename)
 {
     const char *only_fname;
@@ -54,27 +84,243 @@ TbResult wadfile_format_entfile_name(char *entfile, const char *filename)
     return Lb_SUCCESS;
 }
 
-TbResult wadfile_find_index_entry(struct WADIndexEntry *fentry, const char *wadfile, const char *entfile)
+/** Computes hash of WAD entry name, stopping at max length of the name.
+ */
+static ulong wadfile_entry_name_hash(const char *entfile)
+{
+    ulong hash;
+    int i;
+
+    hash = 2166136261u;
+    for (i = 0; i < (int)sizeof(((struct WADIndexEntry *)0)->Filename); i++)
+    {
+        if (entfile[i] == '\0')
+            break;
+        hash ^= (ubyte)entfile[i];
+        hash *= 16777619;
+    }
+    return hash;
+}
+
+static TbBool wadfile_entry_name_matches(const struct WADIndexEntry *fentry, const char *entfile)
+{
+    return (strncmp(entfile, fentry->Filename, sizeof(fentry->Filename)) == 0);
+}
+
+static void wadfile_archive_close(struct WadArchive *p_wad)
+{
+#if WADFILE_USE_MMAP
+    if (p_wad->MapData != NULL)
+        munmap(p_wad->MapData, p_wad->MapSize);
+#endif
+    p_wad->MapData = NULL;
+    p_wad->MapSize = 0;
+    if (p_wad->WadFh != INVALID_FILE)
+        LbFileClose(p_wad->WadFh);
+    p_wad->WadFh = INVALID_FILE;
+    free(p_wad->Index);
+    p_wad->Index = NULL;
+    free(p_wad->HashTable);
+    p_wad->HashTable = NULL;
+    p_wad->EntriesCount = 0;
+    p_wad->HashSize = 0;
+    p_wad->Fname[0] = '\0';
+}
+
+/** Loads the whole WAD index file, and puts its entries into a hash table.
+ */
+static TbResult wadfile_archive_load_index(struct WadArchive *p_wad)
 {
     char locfname[DISKPATH_SIZE];
     TbFileHandle fh;
-    int nread;
+    long len;
+    ulong i;
 
-    sprintf(locfname, "%s.idx", wadfile);
+    snprintf(locfname, sizeof(locfname), "%s.idx", p_wad->Fname);
     fh = LbFileOpen(locfname, Lb_FILE_MODE_READ_ONLY);
     if (fh == INVALID_FILE)
         return Lb_FAIL;
+    len = LbFileLengthHandle(fh);
+    if (len < 0) {
+        LbFileClose(fh);
+        return Lb_FAIL;
+    }
+    p_wad->EntriesCount = len / sizeof(struct WADIndexEntry);
+    len = p_wad->EntriesCount * sizeof(struct WADIndexEntry);
+    p_wad->Index = malloc(len + 1);
+    if (p_wad->Index == NULL) {
+        LbFileClose(fh);
+        return Lb_FAIL;
+    }
+    if (LbFileRead(fh, p_wad->Index, len) != len) {
+        LbFileClose(fh);
+        return Lb_FAIL;
+    }
+    LbFileClose(fh);
 
-    do {
-        nread = LbFileRead(fh, fentry, sizeof(struct WADIndexEntry));
-    } while ((strcmp(entfile, fentry->Filename) != 0) &&
-      (nread == sizeof(struct WADIndexEntry)));
+    // Power of two size, at least twice the entries count, keeps the probe chains short
+    p_wad->HashSize = 16;
+    while (p_wad->HashSize < 2 * p_wad->EntriesCount)
+        p_wad->HashSize <<= 1;
+    p_wad->HashTable = calloc(p_wad->HashSize, sizeof(p_wad->HashTable[0]));
+    if (p_wad->HashTable == NULL)
+        return Lb_FAIL;
 
-    LbFileClose(fh);
+    for (i = 0; i < p_wad->EntriesCount; i++)
+    {
+        struct WADIndexEntry *fentry;
+        ulong n;
+
+        fentry = &p_wad->Index[i];
+        n = wadfile_entry_name_hash(fentry->Filename) & (p_wad->HashSize - 1);
+        while (p_wad->HashTable[n] != 0)
+        {
+            // On duplicate names, the first entry is the one to be found
+            if (wadfile_entry_name_matches(&p_wad->Index[p_wad->HashTable[n] - 1], fentry->Filename))
+                break;
+            n = (n + 1) & (p_wad->HashSize - 1);
+        }
+        if (p_wad->HashTable[n] == 0)
+            p_wad->HashTable[n] = i + 1;
+    }
+    return Lb_SUCCESS;
+}
+
+/** Opens the WAD data file, either by mapping it into memory or by keeping
+ * a handle to read from.
+ */
+static TbResult wadfile_archive_open_data(struct WadArchive *p_wad)
+{
+    char locfname[DISKPATH_SIZE];
 
-    if (nread != sizeof(struct WADIndexEntry))
+    snprintf(locfname, sizeof(locfname), "%s.wad", p_wad->Fname);
+    p_wad->WadFh = LbFileOpen(locfname, Lb_FILE_MODE_READ_ONLY);
+    if (p_wad->WadFh == INVALID_FILE)
         return Lb_FAIL;
+#if WADFILE_USE_MMAP
+    {
+        long len;
+        void *map;
 
+        len = LbFileLengthHandle(p_wad->WadFh);
+        if (len > 0) {
+            map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, (int)p_wad->WadFh, 0);
+            if (map != MAP_FAILED) {
+                p_wad->MapData = map;
+                p_wad->MapSize = len;
+            } else {
+                LOGWARN("%s: Could not map file, will read it instead", locfname);
+            }
+        }
+    }
+#endif
+    return Lb_SUCCESS;
+}
+
+struct WadArchive *wadfile_archive_get(const char *wadfile)
+{
+    struct WadArchive *p_wad;
+    int i;
+
+    wad_archives_use_counter++;
+    for (i = 0; i < WAD_ARCHIVES_LIMIT; i++)
+    {
+        p_wad = &wad_archives[i];
+        if ((p_wad->Fname[0] != '\0') && (strcmp(p_wad->Fname, wadfile) == 0)) {
+            p_wad->LastUse = wad_archives_use_counter;
+            return p_wad;
+        }
+    }
+
+    // Not opened yet; reuse the slot used least recently
+    p_wad = &wad_archives[0];
+    for (i = 1; i < WAD_ARCHIVES_LIMIT; i++)
+    {
+        if (wad_archives[i].LastUse < p_wad->LastUse)
+            p_wad = &wad_archives[i];
+    }
+    wadfile_archive_close(p_wad);
+
+    if (strlen(wadfile) >= sizeof(p_wad->Fname))
+        return NULL;
+    strcpy(p_wad->Fname, wadfile);
+    p_wad->LastUse = wad_archives_use_counter;
+    if ((wadfile_archive_load_index(p_wad) != Lb_SUCCESS) ||
+      (wadfile_archive_open_data(p_wad) != Lb_SUCCESS)) {
+        wadfile_archive_close(p_wad);
+        return NULL;
+    }
+    LOGDBG("%s: Opened archive with %lu entries", wadfile, p_wad->EntriesCount);
+    return p_wad;
+}
+
+void wadfile_archives_close_all(void)
+{
+    int i;
+
+    for (i = 0; i < WAD_ARCHIVES_LIMIT; i++)
+    {
+        wadfile_archive_close(&wad_archives[i]);
+        wad_archives[i].LastUse = 0;
+    }
+}
+
+const struct WADIndexEntry *wadfile_archive_find_entry(struct WadArchive *p_wad, const char *entfile)
+{
+    ulong n;
+
+    n = wadfile_entry_name_hash(entfile) & (p_wad->HashSize - 1);
+    while (p_wad->HashTable[n] != 0)
+    {
+        struct WADIndexEntry *fentry;
+
+        fentry = &p_wad->Index[p_wad->HashTable[n] - 1];
+        if (wadfile_entry_name_matches(fentry, entfile))
+            return fentry;
+        n = (n + 1) & (p_wad->HashSize - 1);
+    }
+    return NULL;
+}
+
+const void *wadfile_archive_entry_view(struct WadArchive *p_wad, const struct WADIndexEntry *fentry)
+{
+    if (p_wad->MapData == NULL)
+        return NULL;
+    if ((fentry->Offset > p_wad->MapSize) || (fentry->Length > p_wad->MapSize - fentry->Offset))
+        return NULL;
+    return p_wad->MapData + fentry->Offset;
+}
+
+long wadfile_archive_entry_read(struct WadArchive *p_wad, const struct WADIndexEntry *fentry, void *outbuf)
+{
+    const void *view;
+
+    view = wadfile_archive_entry_view(p_wad, fentry);
+    if (view != NULL) {
+        memcpy(outbuf, view, fentry->Length);
+        return fentry->Length;
+    }
+    if (p_wad->WadFh == INVALID_FILE)
+        return -1;
+    if (LbFileSeek(p_wad->WadFh, fentry->Offset, Lb_FILE_SEEK_BEGINNING) == Lb_FAIL)
+        return -1;
+    return LbFileRead(p_wad->WadFh, outbuf, fentry->Length);
+}
+
+TbResult wadfile_find_index_entry(struct WADIndexEntry *fentry, const char *wadfile, const char *entfile)
+{
+    struct WadArchive *p_wad;
+    const struct WADIndexEntry *p_fentry;
+
+    p_wad = wadfile_archive_get(wadfile);
+    if (p_wad == NULL)
+        return Lb_FAIL;
+
+    p_fentry = wadfile_archive_find_entry(p_wad, entfile);
+    if (p_fentry == NULL)
+        return Lb_FAIL;
+
+    *fentry = *p_fentry;
     return Lb_SUCCESS;
 }
 
@@ -100,6 +346,7 @@ TbFileHandle open_file_from_wad(const char *filename, const char *wadfile)
     if (ret != Lb_SUCCESS)
         return INVALID_FILE;
 
+    // The caller reads and closes the handle, so it cannot be the shared one
     sprintf(locfname, "%s.wad", wadfile);
     fh = LbFileOpen(locfname, Lb_FILE_MODE_READ_ONLY);
     if (fh == INVALID_FILE)
@@ -112,30 +359,24 @@ TbFileHandle open_file_from_wad(const char *filename, const char *wadfile)
 
 int load_file_wad(const char *filename, const char *wadfile, void *outbuf)
 {
-    char locfname[DISKPATH_SIZE];
     char locstr[64];
-    struct WADIndexEntry fentry;
-    TbFileHandle fh;
+    struct WadArchive *p_wad;
+    const struct WADIndexEntry *fentry;
     TbResult ret;
-    long nread;
 
     ret = wadfile_format_entfile_name(locstr, filename);
     if (ret != Lb_SUCCESS)
         return -1;
 
-    ret = wadfile_find_index_entry(&fentry, wadfile, locstr);
-    if (ret != Lb_SUCCESS)
+    p_wad = wadfile_archive_get(wadfile);
+    if (p_wad == NULL)
         return -1;
 
-    sprintf(locfname, "%s.wad", wadfile);
-    fh = LbFileOpen(locfname, Lb_FILE_MODE_READ_ONLY);
-    if (fh == INVALID_FILE)
+    fentry = wadfile_archive_find_entry(p_wad, locstr);
+    if (fentry == NULL)
         return -1;
 
-    LbFileSeek(fh, fentry.Offset, Lb_FILE_SEEK_BEGINNING);
-    nread = LbFileRead(fh, outbuf, fentry.Length);
-    LbFileClose(fh);
-    return nread;
+    return wadfile_archive_entry_read(p_wad, fentry, outbuf);
 }
 
 int load_file_alltext(const char *filename, void *outbuf)
@@ -26,6 +26,10 @@
 extern "C" {
 #endif
 /******************************************************************************/
+/** Amount of WAD archives which are kept open at the same time.
+ */
+#define WAD_ARCHIVES_LIMIT 8
+
 #pragma pack(1)
 
 struct WADIndexEntry {
@@ -35,8 +39,46 @@ struct WADIndexEntry {
 };
 
 #pragma pack()
+
+struct WadArchive;
+
 /******************************************************************************/
 
+/** Gives WAD archive of given path, opening it if it is not open yet.
+ *
+ * The index of an open archive is held in memory, and its data is either
+ * mapped into memory or read through a handle kept open.
+ *
+ * @param wadfile Path to the archive files, without extension.
+ * @return The archive, or NULL if it could not be opened.
+ */
+struct WadArchive *wadfile_archive_get(const char *wadfile);
+
+/** Closes all open WAD archives.
+ */
+void wadfile_archives_close_all(void);
+
+/** Finds index entry of given name within WAD archive.
+ *
+ * @param entfile Entry name, formatted by wadfile_format_entfile_name().
+ * @return The entry, or NULL if not found.
+ */
+const struct WADIndexEntry *wadfile_archive_find_entry(struct WadArchive *p_wad, const char *entfile);
+
+/** Gives direct access to data of WAD entry, without copying.
+ * Only possible if the archive is mapped into memory; returns NULL otherwise.
+ * The data is valid until the archive is closed.
+ */
+const void *wadfile_archive_entry_view(struct WadArchive *p_wad, const struct WADIndexEntry *fentry);
+
+/** Reads data of WAD entry into given buffer.
+ * @return Amount of bytes read, or -1 on failure.
+ */
+long wadfile_archive_entry_read(struct WadArchive *p_wad, const struct WADIndexEntry *fentry, void *outbuf);
+
+TbResult wadfile_format_entfile_name(char *entfile, const char *filename);
+TbResult wadfile_find_index_entry(struct WADIndexEntry *fentry, const char *wadfile, const char *entfile);
+
 TbFileHandle open_file_from_wad(const char *filename, const char *wadfile);
 int load_file_wad(const char *filename, const char *wadfile, void *outbuf);
 
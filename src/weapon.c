@@ -47,6 +47,7 @@
 #include "player.h"
 #include "research.h"
 #include "thing_search.h"
+#include "thing_sight.h"
 #include "wadfile.h"
 #include "sound.h"
 #include "swlog.h"
@@ -1991,6 +1992,8 @@ void finalise_razor_wire(struct Thing *p_person)
 {
     asm volatile ("call ASM_finalise_razor_wire\n"
         : : "a" (p_person));
+    // Inserts collision vector of the wire
+    thing_sight_memo_clear();
 }
 
 void init_lay_razor(struct Thing *p_thing, short x, short y, short z, int flag)
@@ -2007,6 +2010,13 @@ void update_razor_wire(struct Thing *p_person)
         : : "a" (p_person));
 }
 
+void snap_razor_wire(struct Thing *p_wire)
+{
+    asm volatile ("call ASM_snap_razor_wire\n"
+        : : "a" (p_wire));
+    thing_sight_memo_clear();
+}
+
 void init_laser_beam(struct Thing *p_owner, ushort start_age, ubyte stype)
 {
 #if 0
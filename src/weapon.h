@@ -344,6 +344,9 @@ ushort set_player_weapon_turn(struct Thing *p_person, ushort delay_turns);
 s32 laser_hit_at(s32 x1, s32 y1, s32 z1, s32 *x2, s32 *y2, s32 *z2, struct Thing *p_shot);
 void finalise_razor_wire(struct Thing *p_person);
 void init_lay_razor(struct Thing *p_thing, short x, short y, short z, int flag);
+/** Removes razor wire thing, with its collision vector.
+ */
+void snap_razor_wire(struct Thing *p_wire);
 void init_mgun_laser(struct Thing *p_owner, ushort start_age);
 
 void process_clone_disguise(struct Thing *p_person);
@@ -29,16 +29,13 @@ extern "C" {
 /** Amount of buckets for draw list elements.
  *
  * The buckets are a way of sorting draw items according to depth - like
- * a simplified replacement for the depth buffer.
+ * a simplified replacement for the depth buffer. Each item stores its
+ * bucket, and the items are sorted by it before drawing.
  */
 #define BUCKETS_COUNT 24000
 
 #define BUCKET_MID (BUCKETS_COUNT / 2)
 
-/** Max amount of draw list elements within a bucket.
- */
-#define BUCKET_ITEMS_MAX 2000
-
 #pragma pack(1)
 
 enum DrawItemType {
@@ -94,6 +91,10 @@ enum DrawItemType {
 
 TbBool draw_item_add(ubyte ditype, ushort offset, int bckt);
 
+/** Forgets the already drawn items; to be called when drawlist is reset.
+ */
+void draw_items_sort_reset(void);
+
 void draw_drawlist_1(void);
 void draw_drawlist_2(void);
 void reset_drawlist(void);
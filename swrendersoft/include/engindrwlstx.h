@@ -31,7 +31,8 @@ extern "C" {
 struct DrawItem {
     ubyte Type;
     ushort Offset;
-    ushort Child;
+    /** Depth bucket, used as sorting key when the list is drawn. */
+    ushort Bucket;
 };
 
 struct SpecialPoint {
@@ -136,8 +137,23 @@ void draw_floor_tile1b(ushort tl);
 void set_nuclear_shade_point(s32 x, s32 y, s32 z);
 void set_nuclear_shade_timer(ulong tmval);
 
-void draw_drawitem_1(ushort dihead);
-void draw_drawitem_2(ushort dihead);
+/** Draws one item from the drawlist, in simplified way.
+ */
+void draw_drawitem_1(ushort iidx);
+
+/** Draws one item from the drawlist.
+ */
+void draw_drawitem_2(ushort iidx);
+
+/** Draws a run of drawlist items which all have the same type.
+ *
+ * The type is checked once for the whole run, and the common types are
+ * drawn by loops which only set up the engine state once.
+ *
+ * @param p_iidx Array of indices of the items, in drawing order.
+ * @param count Amount of items in the array; needs to be non-zero.
+ */
+void draw_drawitems_2(const ushort *p_iidx, ushort count);
 
 /******************************************************************************/
 #ifdef __cplusplus
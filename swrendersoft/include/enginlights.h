@@ -78,8 +78,28 @@ extern ushort next_full_light;
 extern struct LightCommand *game_light_commands;
 extern ushort next_light_command;
 
+/** Returns shade accumulated from quick lights chain starting at given index.
+ * Uses the shade cache, unless it awaits a rebuild.
+ */
 uint cummulate_shade_from_quick_lights(ushort light_first);
 
+/** Updates the quick lights shade cache before drawing a frame.
+ *
+ * Invalidates cached shades of chains containing full lights which changed
+ * intensity since the last call; rebuilds the whole cache if the lights
+ * were added or removed.
+ */
+void quick_lights_shade_cache_update(void);
+
+/** Marks the quick lights shade cache for a rebuild.
+ * To be called whenever chains of quick lights could have been modified.
+ */
+void quick_lights_shade_cache_invalidate(void);
+
+/** Frees memory used by the quick lights shade cache.
+ */
+void quick_lights_shade_cache_free(void);
+
 /** Maps fields from old FullLight struct to the current one.
  */
 void refresh_old_full_light_format(struct FullLight *p_fulight,
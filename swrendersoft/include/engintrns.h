@@ -97,6 +97,15 @@ void transform_point(struct EnginePoint *p_ep);
 void transform_shpoint(struct ShEnginePoint *p_sp, int dxc, int dyc, int dzc);
 void transform_shpoint_fpv(struct ShEnginePoint *p_sp, int dxc, int dyc, int dzc);
 
+/** Transform a batch of engine map coordinates into screen positions.
+ *
+ * Gives the same results as calling transform_shpoint() for each point,
+ * but processes several points at once if the CPU supports it.
+ * Coordinates are given as separate arrays, to allow vector loads.
+ */
+void transform_shpoints(const s32 *p_dxc, const s32 *p_dyc, const s32 *p_dzc,
+  struct ShEnginePoint *p_sp, ulong count);
+
 /** Transform coordinates Like transform_shpoint(), but only Y coord is returned.
  *
  * If you need both coords, transforming them at the same time is much faster.
@@ -105,6 +114,10 @@ int transform_shpoint_y(int dxc, int dyc, int dzc);
 
 void transform_screen_to_map_isometric(int *dxc, int *dzc, int scr_x, int scr_y);
 
+/** Updates the view projection factors to current camera angles and window size.
+ */
+void engine_view_trig_update(void);
+
 void process_engine_unk1(void);
 /******************************************************************************/
 #ifdef __cplusplus
@@ -18,6 +18,8 @@
 /******************************************************************************/
 #include "enginbckt.h"
 
+#include "bfmemut.h"
+
 #include "engindrwlstx.h"
 #include "enginpeff.h"
 #include "enginprops.h"
@@ -25,7 +27,19 @@
 /******************************************************************************/
 #define DEBUG_DRAWLIST_BUCKETS_LIMITS 0
 
-ushort buckets[BUCKETS_COUNT];
+/** Amount of draw items which can be addressed by 16-bit index.
+ */
+#define DRAW_ITEMS_INDEX_LIMIT 0x10000
+
+/** Indices of draw items, sorted by bucket before drawing.
+ */
+static ushort draw_items_sorted[DRAW_ITEMS_INDEX_LIMIT];
+static ushort draw_items_sort_tmp[DRAW_ITEMS_INDEX_LIMIT];
+
+/** First draw item which was not drawn yet.
+ * Items below were already drawn, and are kept only until drawlist reset.
+ */
+static ushort draw_items_first_pending = 1;
 
 TbBool draw_item_add(ubyte ditype, ushort offset, int bckt)
 {
@@ -53,43 +67,148 @@ TbBool draw_item_add(ubyte ditype, ushort offset, int bckt)
     p_current_draw_item++;
     p_dritm->Type = ditype;
     p_dritm->Offset = offset;
-    p_dritm->Child = buckets[bckt];
-    buckets[bckt] = next_draw_item;
+    p_dritm->Bucket = bckt;
     next_draw_item++;
     return true;
 }
 
+void draw_items_sort_reset(void)
+{
+    draw_items_first_pending = 1;
+}
+
+/** Sorts pending draw items into drawing order, using two radix passes
+ * over bucket bytes.
+ *
+ * Drawing order is the farthest bucket first, and within a bucket the last
+ * added item first. The sort is stable, so it is enough to store the
+ * result of ascending sort in reverse.
+ *
+ * @return Amount of items in draw_items_sorted[].
+ */
+static ulong draw_items_sort_by_bucket(void)
+{
+    ulong count_lo[256];
+    ulong count_hi[256];
+    ulong i, n, sum;
+    ushort iidx, iidx_beg, iidx_end;
+
+    iidx_beg = draw_items_first_pending;
+    iidx_end = next_draw_item;
+    if (iidx_end <= iidx_beg)
+        return 0;
+    n = iidx_end - iidx_beg;
+
+    LbMemorySet(count_lo, 0, sizeof(count_lo));
+    LbMemorySet(count_hi, 0, sizeof(count_hi));
+    for (iidx = iidx_beg; iidx < iidx_end; iidx++)
+    {
+        ushort bckt;
+
+        bckt = game_draw_list[iidx].Bucket;
+        count_lo[bckt & 0xFF]++;
+        count_hi[bckt >> 8]++;
+    }
+
+    // Turn the counts into starting positions
+    sum = 0;
+    for (i = 0; i < 256; i++) {
+        ulong k = count_lo[i];
+        count_lo[i] = sum;
+        sum += k;
+    }
+    sum = 0;
+    for (i = 0; i < 256; i++) {
+        ulong k = count_hi[i];
+        count_hi[i] = sum;
+        sum += k;
+    }
+
+    for (iidx = iidx_beg; iidx < iidx_end; iidx++)
+    {
+        ushort bckt;
+
+        bckt = game_draw_list[iidx].Bucket;
+        draw_items_sort_tmp[count_lo[bckt & 0xFF]++] = iidx;
+    }
+    for (i = 0; i < n; i++)
+    {
+        ushort bckt;
+
+        iidx = draw_items_sort_tmp[i];
+        bckt = game_draw_list[iidx].Bucket;
+        draw_items_sorted[n - 1 - count_hi[bckt >> 8]++] = iidx;
+    }
+    return n;
+}
+
+/** Returns whether the post effect needs to be called for every bucket,
+ * including the empty ones.
+ */
+static TbBool scene_post_effect_needs_all_buckets(void)
+{
+    return (gamep_scene_effect_type == ScEff_RAIN)
+      || (gamep_scene_effect_type == ScEff_SNOW);
+}
+
+/* TODO drawing the sorted items in screen tiles or bands on worker threads
+ * is not possible yet. Polygon rendering state (vec_mode, vec_colour, vec_map,
+ * polyscans, vec window) is global and shared with the remaining assembly,
+ * and the item drawers call mouse-over picking, while per-bucket rain and
+ * snow change game state. These need to be moved to a per-thread render
+ * context first.
+ */
 void draw_drawlist_1(void)
 {
-    ushort *p_bucket;
-    ushort dihead;
-    short n;
+    ulong i, n;
 
-    p_bucket = &buckets[BUCKETS_COUNT-1];
-    for (n = BUCKETS_COUNT-1; n >= 0; n--)
+    n = draw_items_sort_by_bucket();
+    for (i = 0; i < n; i++)
     {
-        dihead = *p_bucket;
-        *p_bucket = 0;
-        draw_drawitem_1(dihead);
-        p_bucket--;
+        draw_drawitem_1(draw_items_sorted[i]);
     }
+    draw_items_first_pending = next_draw_item;
 }
 
 void draw_drawlist_2(void)
 {
-    ushort *p_bucket;
-    ushort dihead;
-    short n;
+    ulong i, k, n;
+    int effect_bckt;
+    TbBool all_buckets;
 
-    p_bucket = &buckets[BUCKETS_COUNT-1];
-    for (n = BUCKETS_COUNT-1; n >= 0; n--)
+    n = draw_items_sort_by_bucket();
+    all_buckets = scene_post_effect_needs_all_buckets();
+    effect_bckt = BUCKETS_COUNT-1;
+
+    for (i = 0; i < n; i = k)
     {
-        dihead = *p_bucket;
-        *p_bucket = 0;
-        scene_post_effect_for_bucket(n);
-        draw_drawitem_2(dihead);
-        p_bucket--;
+        struct DrawItem *p_dritm;
+
+        p_dritm = &game_draw_list[draw_items_sorted[i]];
+        if (all_buckets) {
+            // Effects for a bucket are drawn before its items
+            for (; effect_bckt >= p_dritm->Bucket; effect_bckt--)
+                scene_post_effect_for_bucket(effect_bckt);
+        }
+        // Find a run of items of the same type; if effects are drawn
+        // between buckets, the run cannot cross a bucket boundary
+        for (k = i + 1; k < n; k++)
+        {
+            struct DrawItem *p_nxitm;
+
+            p_nxitm = &game_draw_list[draw_items_sorted[k]];
+            if (p_nxitm->Type != p_dritm->Type)
+                break;
+            if (all_buckets && (p_nxitm->Bucket != p_dritm->Bucket))
+                break;
+        }
+        draw_drawitems_2(&draw_items_sorted[i], k - i);
+    }
+    if (all_buckets) {
+        for (; effect_bckt >= 0; effect_bckt--)
+            scene_post_effect_for_bucket(effect_bckt);
     }
+    draw_items_first_pending = next_draw_item;
 }
 
 /******************************************************************************/
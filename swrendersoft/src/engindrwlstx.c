@@ -67,6 +67,8 @@ void draw_special_object_face4(ushort face4);
 void draw_object_face4_pole(ushort face4);
 void draw_object_face4d_textrd(ushort face4);
 void draw_object_face3d_textrd(ushort face);
+void draw_object_faces4d_textrd(const ushort *p_iidx, ushort count);
+void draw_object_faces3d_textrd(const ushort *p_iidx, ushort count);
 void draw_object_face3d_textrd_dk(ushort face);
 void draw_object_face3_tran_tint(ushort face);
 void draw_object_face4_tran_tint(ushort face4);
@@ -96,170 +98,208 @@ void reset_drawlist(void)
     tnext_floor_texture = next_floor_texture;
 
     next_floor_tile = 1;
+
+    draw_items_sort_reset();
 }
 
 // Special non-textured draw; used during nuclear explosions?
-void draw_drawitem_1(ushort dihead)
+void draw_drawitem_1(ushort iidx)
 {
     struct DrawItem *itm;
-    ushort iidx;
 
-    for (iidx = dihead; iidx != 0; iidx = itm->Child)
+    itm = &game_draw_list[iidx];
+    switch (itm->Type)
     {
-      itm = &game_draw_list[iidx];
-      switch (itm->Type)
-      {
-      case DrIT_ObFace3Txtr:
-      case DrIT_Unkn10:
-          draw_object_face3d_textrd_dk(itm->Offset);
-          break;
-      case DrIT_Unkn2:
-      case DrIT_Unkn8:
-          break;
-      case DrIT_SFrmStatc:
-          draw_sort_sprite1a(itm->Offset);
-          break;
-      case DrIT_Unkn4:
-          draw_floor_tile1a(itm->Offset);
-          break;
-      case DrIT_Unkn5:
-          draw_ex_face(itm->Offset);
-          break;
-      case DrIT_Unkn6:
-          draw_floor_tile1b(itm->Offset);
-          break;
-      case DrIT_ObFace3G:
-          draw_object_face3g_textrd(itm->Offset);
-          break;
-      case DrIT_ObFace4Txtr:
-          draw_object_face4d_textrd_dk(itm->Offset);
-          break;
-      case DrIT_Unkn11:
-          draw_sort_line1a(itm->Offset);
-          break;
-      case DrIT_SpObFace4:
-          draw_special_object_face4(itm->Offset);
-          break;
-      case DrIT_SFrmPersV:
-          draw_sort_sprite_frame_pers_v(itm->Offset);
-          break;
-      case DrIT_SFrmPersB:
-          draw_sort_sprite_frame_pers_b(itm->Offset);
-          break;
-      case DrIT_SFrmEfctV:
-          draw_sort_sprite_frame_efct_v(itm->Offset);
-          break;
-      case DrIT_ObFacePole:
-          draw_object_face4_pole(itm->Offset);
-          break;
-      case DrIT_Unkn15:
-          draw_sort_sprite1c(itm->Offset);
-          break;
-      }
+    case DrIT_ObFace3Txtr:
+    case DrIT_Unkn10:
+        draw_object_face3d_textrd_dk(itm->Offset);
+        break;
+    case DrIT_Unkn2:
+    case DrIT_Unkn8:
+        break;
+    case DrIT_SFrmStatc:
+        draw_sort_sprite1a(itm->Offset);
+        break;
+    case DrIT_Unkn4:
+        draw_floor_tile1a(itm->Offset);
+        break;
+    case DrIT_Unkn5:
+        draw_ex_face(itm->Offset);
+        break;
+    case DrIT_Unkn6:
+        draw_floor_tile1b(itm->Offset);
+        break;
+    case DrIT_ObFace3G:
+        draw_object_face3g_textrd(itm->Offset);
+        break;
+    case DrIT_ObFace4Txtr:
+        draw_object_face4d_textrd_dk(itm->Offset);
+        break;
+    case DrIT_Unkn11:
+        draw_sort_line1a(itm->Offset);
+        break;
+    case DrIT_SpObFace4:
+        draw_special_object_face4(itm->Offset);
+        break;
+    case DrIT_SFrmPersV:
+        draw_sort_sprite_frame_pers_v(itm->Offset);
+        break;
+    case DrIT_SFrmPersB:
+        draw_sort_sprite_frame_pers_b(itm->Offset);
+        break;
+    case DrIT_SFrmEfctV:
+        draw_sort_sprite_frame_efct_v(itm->Offset);
+        break;
+    case DrIT_ObFacePole:
+        draw_object_face4_pole(itm->Offset);
+        break;
+    case DrIT_Unkn15:
+        draw_sort_sprite1c(itm->Offset);
+        break;
     }
 }
 
-void draw_drawitem_2(ushort dihead)
+void draw_drawitem_2(ushort iidx)
 {
     struct DrawItem *itm;
-    ushort iidx;
+
+    assert(screen_position_face_render_cb != NULL);
+    assert(screen_sorted_sprite_statc_render_cb != NULL);
+    assert(screen_sorted_sprite_persn_render_cb != NULL);
+
+    itm = &game_draw_list[iidx];
+    switch (itm->Type)
+    {
+    case DrIT_ObFace3Txtr:
+    case DrIT_Unkn10:
+        draw_object_face3d_textrd(itm->Offset);
+        break;
+    case DrIT_SFrmStatc:
+        draw_sort_sprite1a(itm->Offset);
+        break;
+    case DrIT_Unkn4:
+        draw_floor_tile1a(itm->Offset);
+        break;
+    case DrIT_Unkn5:
+        draw_ex_face(itm->Offset);
+        break;
+    case DrIT_Unkn6:
+        draw_floor_tile1b(itm->Offset);
+        break;
+    case DrIT_ObFace3G:
+        draw_object_face3g_textrd(itm->Offset);
+        break;
+    case DrIT_ObFace4Txtr:
+        draw_object_face4d_textrd(itm->Offset);
+        break;
+    case DrIT_Unkn11:
+        draw_sort_line1a(itm->Offset);
+        break;
+    case DrIT_SpObFace4:
+        draw_special_object_face4(itm->Offset);
+        break;
+    case DrIT_SFrmPersV:
+        draw_sort_sprite_frame_pers_v(itm->Offset);
+        break;
+    case DrIT_SFrmPersB:
+        draw_sort_sprite_frame_pers_b(itm->Offset);
+        break;
+    case DrIT_SFrmEfctV:
+        draw_sort_sprite_frame_efct_v(itm->Offset);
+        break;
+    case DrIT_ObFacePole:
+        draw_object_face4_pole(itm->Offset);
+        break;
+    case DrIT_Unkn15:
+        draw_sort_sprite1c(itm->Offset);
+        break;
+    case DrIT_ObFace4G:
+        draw_object_face4g_textrd(itm->Offset);
+        break;
+    case DrIT_ObFace3Refl:
+        draw_object_face3_reflect(itm->Offset);
+        break;
+    case DrIT_ObFace4Refl:
+        draw_object_face4_reflect(itm->Offset);
+        break;
+    case DrIT_SPersShdw:
+        draw_sort_sprite_person_shadow(itm->Offset);
+        break;
+    case DrIT_SharpnlPoly:
+        draw_shrapnel(itm->Offset);
+        break;
+    case DrIT_SFrmPhwoar:
+        draw_phwoar(itm->Offset);
+        break;
+    case DrIT_LongPropBar:
+        draw_sort_sprite_long_prop_bar(itm->Offset);
+        break;
+    case DrIT_ObFace4Tran:
+        draw_object_face4_tran_tint(itm->Offset);
+        break;
+    case DrIT_ObFace3Tran:
+        draw_object_face3_tran_tint(itm->Offset);
+        break;
+    case DrIT_SFireFlame:
+        draw_fire_flame(itm->Offset);
+        break;
+    case DrIT_Number:
+        draw_sort_sprite_number(itm->Offset);
+        break;
+    case DrIT_ShortText:
+        draw_sort_sprite_short_text(itm->Offset);
+        break;
+    default:
+        break;
+    }
+}
+
+void draw_drawitems_2(const ushort *p_iidx, ushort count)
+{
     ushort i;
 
     assert(screen_position_face_render_cb != NULL);
     assert(screen_sorted_sprite_statc_render_cb != NULL);
     assert(screen_sorted_sprite_persn_render_cb != NULL);
 
-    i = 0;
-    for (iidx = dihead; iidx != 0; iidx = itm->Child)
+    // Only the most common types get their own loop; the rest goes per item
+    switch (game_draw_list[p_iidx[0]].Type)
     {
-      i++;
-      if (i > BUCKET_ITEMS_MAX)
-          break;
-      itm = &game_draw_list[iidx];
-      switch (itm->Type)
-      {
-      case DrIT_ObFace3Txtr:
-      case DrIT_Unkn10:
-          draw_object_face3d_textrd(itm->Offset);
-          break;
-      case DrIT_SFrmStatc:
-          draw_sort_sprite1a(itm->Offset);
-          break;
-      case DrIT_Unkn4:
-          draw_floor_tile1a(itm->Offset);
-          break;
-      case DrIT_Unkn5:
-          draw_ex_face(itm->Offset);
-          break;
-      case DrIT_Unkn6:
-          draw_floor_tile1b(itm->Offset);
-          break;
-      case DrIT_ObFace3G:
-          draw_object_face3g_textrd(itm->Offset);
-          break;
-      case DrIT_ObFace4Txtr:
-          draw_object_face4d_textrd(itm->Offset);
-          break;
-      case DrIT_Unkn11:
-          draw_sort_line1a(itm->Offset);
-          break;
-      case DrIT_SpObFace4:
-          draw_special_object_face4(itm->Offset);
-          break;
-      case DrIT_SFrmPersV:
-          draw_sort_sprite_frame_pers_v(itm->Offset);
-          break;
-      case DrIT_SFrmPersB:
-          draw_sort_sprite_frame_pers_b(itm->Offset);
-          break;
-      case DrIT_SFrmEfctV:
-          draw_sort_sprite_frame_efct_v(itm->Offset);
-          break;
-      case DrIT_ObFacePole:
-          draw_object_face4_pole(itm->Offset);
-          break;
-      case DrIT_Unkn15:
-          draw_sort_sprite1c(itm->Offset);
-          break;
-      case DrIT_ObFace4G:
-          draw_object_face4g_textrd(itm->Offset);
-          break;
-      case DrIT_ObFace3Refl:
-          draw_object_face3_reflect(itm->Offset);
-          break;
-      case DrIT_ObFace4Refl:
-          draw_object_face4_reflect(itm->Offset);
-          break;
-      case DrIT_SPersShdw:
-          draw_sort_sprite_person_shadow(itm->Offset);
-          break;
-      case DrIT_SharpnlPoly:
-          draw_shrapnel(itm->Offset);
-          break;
-      case DrIT_SFrmPhwoar:
-          draw_phwoar(itm->Offset);
-          break;
-      case DrIT_LongPropBar:
-          draw_sort_sprite_long_prop_bar(itm->Offset);
-          break;
-      case DrIT_ObFace4Tran:
-          draw_object_face4_tran_tint(itm->Offset);
-          break;
-      case DrIT_ObFace3Tran:
-          draw_object_face3_tran_tint(itm->Offset);
-          break;
-      case DrIT_SFireFlame:
-          draw_fire_flame(itm->Offset);
-          break;
-      case DrIT_Number:
-          draw_sort_sprite_number(itm->Offset);
-          break;
-      case DrIT_ShortText:
-          draw_sort_sprite_short_text(itm->Offset);
-          break;
-      default:
-          break;
-      }
+    case DrIT_ObFace3Txtr:
+    case DrIT_Unkn10:
+        draw_object_faces3d_textrd(p_iidx, count);
+        break;
+    case DrIT_ObFace4Txtr:
+        draw_object_faces4d_textrd(p_iidx, count);
+        break;
+    case DrIT_ObFace3G:
+        for (i = 0; i < count; i++)
+            draw_object_face3g_textrd(game_draw_list[p_iidx[i]].Offset);
+        break;
+    case DrIT_ObFace4G:
+        for (i = 0; i < count; i++)
+            draw_object_face4g_textrd(game_draw_list[p_iidx[i]].Offset);
+        break;
+    case DrIT_Unkn4:
+        for (i = 0; i < count; i++)
+            draw_floor_tile1a(game_draw_list[p_iidx[i]].Offset);
+        break;
+    case DrIT_Unkn6:
+        for (i = 0; i < count; i++)
+            draw_floor_tile1b(game_draw_list[p_iidx[i]].Offset);
+        break;
+    case DrIT_SFrmStatc:
+        for (i = 0; i < count; i++)
+            draw_sort_sprite1a(game_draw_list[p_iidx[i]].Offset);
+        break;
+    case DrIT_SFrmPersV:
+        for (i = 0; i < count; i++)
+            draw_sort_sprite_frame_pers_v(game_draw_list[p_iidx[i]].Offset);
+        break;
+    default:
+        for (i = 0; i < count; i++)
+            draw_drawitem_2(p_iidx[i]);
+        break;
     }
 }
 /******************************************************************************/
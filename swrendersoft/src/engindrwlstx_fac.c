@@ -71,8 +71,30 @@ ubyte engine_render_lights = 0;
 TbPixel face_transp_tinted_surface_col = 0;
 TbPixel face_transp_tinted_line_col = 0;
 
+/** Engine state which stays unchanged while drawing a run of faces.
+ *
+ * Copied to local struct, so that the values do not have to be re-read
+ * from globals after each call to the polygon rasterizer.
+ */
+struct FaceDrawSetup {
+    s32 ShiftX;
+    s32 ShiftY;
+    u32 AnimTurn;
+    ubyte Perspective;
+    ubyte Lights;
+};
+
 /******************************************************************************/
 
+static void face_draw_setup_init(struct FaceDrawSetup *p_fds)
+{
+    p_fds->ShiftX = dword_176D00;
+    p_fds->ShiftY = dword_176D04;
+    p_fds->AnimTurn = render_anim_turn;
+    p_fds->Perspective = game_perspective;
+    p_fds->Lights = engine_render_lights;
+}
+
 void set_floor_texture_uv(ushort sftex, struct PolyPoint *p_pt1, struct PolyPoint *p_pt2,
   struct PolyPoint *p_pt3, struct PolyPoint *p_pt4, ubyte gflags)
 {
@@ -1424,7 +1446,7 @@ void draw_object_face4_pole(ushort face4)
  *
  * @param face3 Index in `game_object_faces3` array.
  */
-void draw_object_face3d_textrd(ushort face3)
+static void draw_object_face3d_textrd_sub(ushort face3, const struct FaceDrawSetup *p_fds)
 {
     struct PolyPoint point1;
     struct PolyPoint point2;
@@ -1439,7 +1461,7 @@ void draw_object_face3d_textrd(ushort face3)
     {
         if ((p_face->GFlags & FGFlg_Unkn40) != 0) {
             uint frame;
-            frame = render_anim_turn + p_face->Object;
+            frame = p_fds->AnimTurn + p_face->Object;
             if ((frame & 0x1FF) > 0x100 && !byte_153014[frame & 0x3F])
                 vec_mode = 5;
         }
@@ -1452,8 +1474,8 @@ void draw_object_face3d_textrd(ushort face3)
 
         p_point = &game_object_points[p_face->PointNo[0]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point1.X = p_scrpoint->X + dword_176D00;
-        point1.Y = p_scrpoint->Y + dword_176D04;
+        point1.X = p_scrpoint->X + p_fds->ShiftX;
+        point1.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
     if ((vec_mode == 2) || (vec_mode == 0))
     {
@@ -1476,10 +1498,10 @@ void draw_object_face3d_textrd(ushort face3)
 
         p_point = &game_object_points[p_face->PointNo[2]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point2.X = p_scrpoint->X + dword_176D00;
-        point2.Y = p_scrpoint->Y + dword_176D04;
+        point2.X = p_scrpoint->X + p_fds->ShiftX;
+        point2.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
-    if (game_perspective == 7)
+    if (p_fds->Perspective == 7)
     {
         vec_mode = 7;
         vec_colour = point1.S >> 16;
@@ -1507,8 +1529,8 @@ void draw_object_face3d_textrd(ushort face3)
 
             p_point = &game_object_points[p_face->PointNo[1]];
             p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-            point3.X = p_scrpoint->X + dword_176D00;
-            point3.Y = p_scrpoint->Y + dword_176D04;
+            point3.X = p_scrpoint->X + p_fds->ShiftX;
+            point3.Y = p_scrpoint->Y + p_fds->ShiftY;
         }
         if ((vec_mode == 2) || (vec_mode == 0))
         {
@@ -1532,11 +1554,11 @@ void draw_object_face3d_textrd(ushort face3)
 
         p_point = &game_object_points[p_face->PointNo[1]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point3.X = p_scrpoint->X + dword_176D00;
-        point3.Y = p_scrpoint->Y + dword_176D04;
+        point3.X = p_scrpoint->X + p_fds->ShiftX;
+        point3.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
 
-    if (!engine_render_lights)
+    if (!p_fds->Lights)
     {
         point1.S = 0x200000;
         point2.S = 0x200000;
@@ -1544,7 +1566,7 @@ void draw_object_face3d_textrd(ushort face3)
     }
     dword_176D4C++;
 
-    if (game_perspective == 3)
+    if (p_fds->Perspective == 3)
     {
         vec_mode = 0;
         vec_colour = pixmap.fade_table[256 * (point3.S >> 16) + colour_lookup[ColLU_RED]];
@@ -1577,13 +1599,33 @@ void draw_object_face3d_textrd(ushort face3)
     }
 }
 
+void draw_object_face3d_textrd(ushort face3)
+{
+    struct FaceDrawSetup fds;
+
+    face_draw_setup_init(&fds);
+    draw_object_face3d_textrd_sub(face3, &fds);
+}
+
+void draw_object_faces3d_textrd(const ushort *p_iidx, ushort count)
+{
+    struct FaceDrawSetup fds;
+    ushort i;
+
+    face_draw_setup_init(&fds);
+    for (i = 0; i < count; i++)
+    {
+        draw_object_face3d_textrd_sub(game_draw_list[p_iidx[i]].Offset, &fds);
+    }
+}
+
 /**
  * Draw rectangular face with textured surface, version D.
  * TODO: figure out how this version is unique.
  *
  * @param face4 Index in `game_object_faces4` array.
  */
-void draw_object_face4d_textrd(ushort face4)
+static void draw_object_face4d_textrd_sub(ushort face4, const struct FaceDrawSetup *p_fds)
 {
     struct SingleObjectFace4 *p_face4;
     struct PolyPoint point3;
@@ -1598,7 +1640,7 @@ void draw_object_face4d_textrd(ushort face4)
     {
         if ((p_face4->GFlags & FGFlg_Unkn40) != 0) {
             uint frame;
-            frame = render_anim_turn + p_face4->Object;
+            frame = p_fds->AnimTurn + p_face4->Object;
             if ((frame & 0x1FF) > 0x100 && !byte_153014[frame & 0x3F])
                 vec_mode = 5;
         }
@@ -1617,8 +1659,8 @@ void draw_object_face4d_textrd(ushort face4)
 
         p_point = &game_object_points[p_face4->PointNo[0]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point1.X = p_scrpoint->X + dword_176D00;
-        point1.Y = p_scrpoint->Y + dword_176D04;
+        point1.X = p_scrpoint->X + p_fds->ShiftX;
+        point1.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
     if (vec_mode == 2)
     {
@@ -1641,10 +1683,10 @@ void draw_object_face4d_textrd(ushort face4)
 
         p_point = &game_object_points[p_face4->PointNo[2]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point2.X = p_scrpoint->X + dword_176D00;
-        point2.Y = p_scrpoint->Y + dword_176D04;
+        point2.X = p_scrpoint->X + p_fds->ShiftX;
+        point2.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
-    if (game_perspective == 7)
+    if (p_fds->Perspective == 7)
     {
         vec_mode = 7;
         vec_colour = point1.S >> 16;
@@ -1703,8 +1745,8 @@ void draw_object_face4d_textrd(ushort face4)
 
         p_point = &game_object_points[p_face4->PointNo[1]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point3.X = p_scrpoint->X + dword_176D00;
-        point3.Y = p_scrpoint->Y + dword_176D04;
+        point3.X = p_scrpoint->X + p_fds->ShiftX;
+        point3.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
     {
         struct SinglePoint *p_point;
@@ -1712,11 +1754,11 @@ void draw_object_face4d_textrd(ushort face4)
 
         p_point = &game_object_points[p_face4->PointNo[3]];
         p_scrpoint = &game_screen_point_pool[p_point->PointOffset];
-        point4.X = p_scrpoint->X + dword_176D00;
-        point4.Y = p_scrpoint->Y + dword_176D04;
+        point4.X = p_scrpoint->X + p_fds->ShiftX;
+        point4.Y = p_scrpoint->Y + p_fds->ShiftY;
     }
 
-    if (!engine_render_lights)
+    if (!p_fds->Lights)
     {
         point1.S = 0x200000;
         point2.S = 0x200000;
@@ -1774,6 +1816,26 @@ void draw_object_face4d_textrd(ushort face4)
     }
 }
 
+void draw_object_face4d_textrd(ushort face4)
+{
+    struct FaceDrawSetup fds;
+
+    face_draw_setup_init(&fds);
+    draw_object_face4d_textrd_sub(face4, &fds);
+}
+
+void draw_object_faces4d_textrd(const ushort *p_iidx, ushort count)
+{
+    struct FaceDrawSetup fds;
+    ushort i;
+
+    face_draw_setup_init(&fds);
+    for (i = 0; i < count; i++)
+    {
+        draw_object_face4d_textrd_sub(game_draw_list[p_iidx[i]].Offset, &fds);
+    }
+}
+
 /**
  * Draw triangular face with normally textured surface, but dark.
  *
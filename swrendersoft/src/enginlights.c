@@ -6,7 +6,8 @@
  * @par Purpose:
  *     Implement functions for handling lights in 3D world.
  * @par Comment:
- *     None.
+ *     Shades of quick light chains are cached, and recomputed only after
+ *     intensity of any full light in the chain changes.
  * @author   Tomasz Lis
  * @date     19 Apr 2022 - 27 Aug 2023
  * @par  Copying and copyrights:
@@ -18,6 +19,7 @@
 /******************************************************************************/
 #include "enginlights.h"
 
+#include "bfmemory.h"
 #include "bfmemut.h"
 
 #include "privrdlog.h"
@@ -32,7 +34,43 @@ ushort next_full_light = 1;
 struct LightCommand *game_light_commands = NULL;
 ushort next_light_command = 1;
 
-uint cummulate_shade_from_quick_lights(ushort light_first)
+/** Cached shade of quick lights chain, and reverse links used for invalidation.
+ * Indexed by quick light; the shade is valid only for chain heads.
+ */
+struct QuickLightShadeCache {
+    uint Shade;
+    /** Head of the cached chain this quick light belongs to, or 0 if not linked. */
+    ushort Head;
+    /** Next quick light linked to the same full light. */
+    ushort NextLink;
+    ubyte Valid;
+};
+
+/** Intensity for which the shade cache was computed, and list of quick lights
+ * using given full light. Indexed by full light.
+ */
+struct FullLightShadeCache {
+    short Intensity;
+    ushort FirstLink;
+};
+
+static struct QuickLightShadeCache *quick_lights_shade = NULL;
+static ushort quick_lights_shade_count = 0;
+static struct FullLightShadeCache *full_lights_shade = NULL;
+static ushort full_lights_shade_count = 0;
+
+/** Lights pools state for which the cache was filled. */
+static struct QuickLight *shade_cache_quick_lights = NULL;
+static struct FullLight *shade_cache_full_lights = NULL;
+static ushort shade_cache_next_quick_light = 0;
+static ushort shade_cache_next_full_light = 0;
+
+/** Set when chains of quick lights could have changed; the cache is not
+ * used until rebuilt by quick_lights_shade_cache_update().
+ */
+static TbBool shade_cache_needs_flush = true;
+
+static uint cummulate_shade_from_quick_lights_direct(ushort light_first)
 {
         struct QuickLight *p_qlight;
         ushort light;
@@ -53,6 +91,153 @@ uint cummulate_shade_from_quick_lights(ushort light_first)
         return shade;
 }
 
+/** Links quick lights of given chain to their full lights, so that the chain
+ * shade can be invalidated when any of the lights changes.
+ * Returns false if the chain cannot be cached.
+ */
+static TbBool quick_lights_shade_link_chain(ushort light_first)
+{
+    struct QuickLight *p_qlight;
+    ushort light;
+    short i;
+
+    for (light = light_first, i = 0; light != 0; light = p_qlight->NextQuick, i++)
+    {
+        struct QuickLightShadeCache *p_qlsc;
+        struct FullLightShadeCache *p_flsc;
+
+        if (i > MAX_LIGHTS_AFFECTING_FACE)
+            break;
+        p_qlight = &game_quick_lights[light];
+        if ((light >= quick_lights_shade_count) || (p_qlight->Light >= full_lights_shade_count))
+            return false;
+        p_qlsc = &quick_lights_shade[light];
+        if (p_qlsc->Head == light_first)
+            continue;
+        // A quick light shared between chains would need more links
+        if (p_qlsc->Head != 0)
+            return false;
+        p_flsc = &full_lights_shade[p_qlight->Light];
+        p_qlsc->Head = light_first;
+        p_qlsc->NextLink = p_flsc->FirstLink;
+        p_flsc->FirstLink = light;
+    }
+    return true;
+}
+
+uint cummulate_shade_from_quick_lights(ushort light_first)
+{
+    struct QuickLightShadeCache *p_qlsc;
+    uint shade;
+
+    if (light_first == 0)
+        return 0;
+    if (shade_cache_needs_flush || (light_first >= quick_lights_shade_count))
+        return cummulate_shade_from_quick_lights_direct(light_first);
+
+    p_qlsc = &quick_lights_shade[light_first];
+    if (p_qlsc->Valid)
+        return p_qlsc->Shade;
+
+    shade = cummulate_shade_from_quick_lights_direct(light_first);
+    if (quick_lights_shade_link_chain(light_first)) {
+        p_qlsc->Shade = shade;
+        p_qlsc->Valid = true;
+    }
+    return shade;
+}
+
+static void quick_lights_shade_cache_realloc(void)
+{
+    ulong count;
+
+    if ((quick_lights_shade == NULL) || (quick_lights_shade_count < next_quick_light))
+    {
+        LbMemoryFree(quick_lights_shade);
+        count = next_quick_light + next_quick_light / 4 + 64;
+        if (count > 0xFFFF)
+            count = 0xFFFF;
+        quick_lights_shade = LbMemoryAlloc(count * sizeof(struct QuickLightShadeCache));
+        quick_lights_shade_count = (quick_lights_shade != NULL) ? count : 0;
+    }
+    if ((full_lights_shade == NULL) || (full_lights_shade_count < next_full_light))
+    {
+        LbMemoryFree(full_lights_shade);
+        count = next_full_light + next_full_light / 4 + 16;
+        if (count > 0xFFFF)
+            count = 0xFFFF;
+        full_lights_shade = LbMemoryAlloc(count * sizeof(struct FullLightShadeCache));
+        full_lights_shade_count = (full_lights_shade != NULL) ? count : 0;
+    }
+}
+
+static void quick_lights_shade_cache_flush(void)
+{
+    ushort light;
+
+    quick_lights_shade_cache_realloc();
+    if (quick_lights_shade != NULL)
+        LbMemorySet(quick_lights_shade, 0, quick_lights_shade_count * sizeof(struct QuickLightShadeCache));
+    if (full_lights_shade != NULL)
+        LbMemorySet(full_lights_shade, 0, full_lights_shade_count * sizeof(struct FullLightShadeCache));
+    for (light = 0; (light < next_full_light) && (light < full_lights_shade_count); light++)
+        full_lights_shade[light].Intensity = game_full_lights[light].Intensity;
+
+    shade_cache_quick_lights = game_quick_lights;
+    shade_cache_full_lights = game_full_lights;
+    shade_cache_next_quick_light = next_quick_light;
+    shade_cache_next_full_light = next_full_light;
+    shade_cache_needs_flush = false;
+}
+
+void quick_lights_shade_cache_update(void)
+{
+    ushort light;
+
+    if ((game_quick_lights == NULL) || (game_full_lights == NULL))
+        return;
+    if ((shade_cache_quick_lights != game_quick_lights) ||
+      (shade_cache_full_lights != game_full_lights) ||
+      (shade_cache_next_quick_light != next_quick_light) ||
+      (shade_cache_next_full_light != next_full_light))
+        shade_cache_needs_flush = true;
+    if (shade_cache_needs_flush) {
+        quick_lights_shade_cache_flush();
+        return;
+    }
+
+    for (light = 0; (light < next_full_light) && (light < full_lights_shade_count); light++)
+    {
+        struct FullLightShadeCache *p_flsc;
+        ushort qlight;
+
+        p_flsc = &full_lights_shade[light];
+        if (p_flsc->Intensity == game_full_lights[light].Intensity)
+            continue;
+        p_flsc->Intensity = game_full_lights[light].Intensity;
+        for (qlight = p_flsc->FirstLink; qlight != 0; qlight = quick_lights_shade[qlight].NextLink)
+        {
+            quick_lights_shade[quick_lights_shade[qlight].Head].Valid = false;
+        }
+    }
+}
+
+void quick_lights_shade_cache_invalidate(void)
+{
+    shade_cache_needs_flush = true;
+}
+
+void quick_lights_shade_cache_free(void)
+{
+    LbMemoryFree(quick_lights_shade);
+    quick_lights_shade = NULL;
+    quick_lights_shade_count = 0;
+    LbMemoryFree(full_lights_shade);
+    full_lights_shade = NULL;
+    full_lights_shade_count = 0;
+    shade_cache_needs_flush = true;
+}
+
 void refresh_old_full_light_format(struct FullLight *p_fulight,
   struct FullLightOldV12 *p_oldfulight, u32 fmtver)
 {
@@ -36,6 +36,15 @@ s32 dword_176D40;
 s32 dword_176D44;
 s32 dword_176D4C;
 s32 cam_rotation_velocity = 0;
+
+enum TransformBatchKernel {
+    TrBK_None = 0,
+    TrBK_Scalar,
+    TrBK_SSE41,
+    TrBK_AVX2,
+};
+
+static ubyte transform_batch_kernel = TrBK_None;
 /******************************************************************************/
 
 /**
@@ -302,14 +311,227 @@ int transform_shpoint_y(int dxc, int dyc, int dzc)
     return scr_y;
 }
 
-void process_engine_unk1(void)
+static void transform_shpoints_scalar(const s32 *p_dxc, const s32 *p_dyc,
+  const s32 *p_dzc, struct ShEnginePoint *p_sp, ulong count)
+{
+    ulong i;
+
+    for (i = 0; i < count; i++)
+        transform_shpoint(&p_sp[i], p_dxc[i], p_dyc[i], p_dzc[i]);
+}
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define TRANSFORM_HAVE_X86_SIMD 1
+#include <immintrin.h>
+
+/** Stores 4 lanes of transform_shpoint() results into ShEnginePoint structs.
+ */
+__attribute__((target("sse4.1")))
+static void transform_shpoints_store4_sse41(struct ShEnginePoint *p_sp,
+  __m128i scr_x, __m128i scr_y, __m128i scr_d, __m128i flg)
+{
+    s32 x[4], y[4], d[4], f[4];
+    int k;
+
+    _mm_storeu_si128((__m128i *)x, scr_x);
+    _mm_storeu_si128((__m128i *)y, scr_y);
+    _mm_storeu_si128((__m128i *)d, scr_d);
+    _mm_storeu_si128((__m128i *)f, flg);
+    for (k = 0; k < 4; k++) {
+        p_sp[k].Flags = f[k];
+        p_sp[k].X = x[k];
+        p_sp[k].Y = y[k];
+        p_sp[k].Depth = d[k];
+    }
+}
+
+__attribute__((target("sse4.1")))
+static void transform_shpoints_sse41(const s32 *p_dxc, const s32 *p_dyc,
+  const s32 *p_dzc, struct ShEnginePoint *p_sp, ulong count)
+{
+    __m128i rot_a, rot_b, rot_c, rot_d, scale;
+    __m128i cntr_x, cntr_y, win_w, win_h, coord_min, coord_max;
+    __m128i zero, flg_base;
+    ulong i;
+
+    rot_a = _mm_set1_epi32(dword_176D10);
+    rot_b = _mm_set1_epi32(dword_176D14);
+    rot_c = _mm_set1_epi32(dword_176D18);
+    rot_d = _mm_set1_epi32(dword_176D1C);
+    scale = _mm_set1_epi32(overall_scale);
+    cntr_x = _mm_set1_epi32(dword_176D3C);
+    cntr_y = _mm_set1_epi32(dword_176D40);
+    // Compared with greater-than, so the window size is decreased by one
+    win_w = _mm_set1_epi32(vec_window_width - 1);
+    win_h = _mm_set1_epi32(vec_window_height - 1);
+    coord_min = _mm_set1_epi32(SCREEN_POINT_COORD_MIN);
+    coord_max = _mm_set1_epi32(SCREEN_POINT_COORD_MAX);
+    zero = _mm_setzero_si128();
+    flg_base = _mm_set1_epi32(0x40);
+
+    for (i = 0; i + 4 <= count; i += 4)
+    {
+        __m128i dxc, dyc, dzc;
+        __m128i fctr_a, fctr_b, fctr_c, scr_d;
+        __m128i scr_x, scr_y, flg, below, above;
+
+        dxc = _mm_loadu_si128((const __m128i *)(p_dxc + i));
+        dyc = _mm_loadu_si128((const __m128i *)(p_dyc + i));
+        dzc = _mm_loadu_si128((const __m128i *)(p_dzc + i));
+
+        fctr_a = _mm_srai_epi32(_mm_sub_epi32(_mm_mullo_epi32(rot_b, dxc),
+          _mm_mullo_epi32(rot_a, dzc)), 16);
+        fctr_b = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(rot_a, dxc),
+          _mm_mullo_epi32(rot_b, dzc)), 16);
+        fctr_c = _mm_srai_epi32(_mm_sub_epi32(_mm_mullo_epi32(rot_d, dyc),
+          _mm_mullo_epi32(rot_c, fctr_b)), 16);
+        scr_d = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(rot_c, dyc),
+          _mm_mullo_epi32(rot_d, fctr_b)), 16);
+
+        scr_x = _mm_add_epi32(cntr_x,
+          _mm_srai_epi32(_mm_mullo_epi32(scale, fctr_a), 11));
+        below = _mm_cmplt_epi32(scr_x, zero);
+        above = _mm_andnot_si128(below, _mm_cmpgt_epi32(scr_x, win_w));
+        flg = _mm_or_si128(flg_base, _mm_and_si128(below, _mm_set1_epi32(0x01)));
+        flg = _mm_or_si128(flg, _mm_and_si128(above, _mm_set1_epi32(0x02)));
+        scr_x = _mm_min_epi32(_mm_max_epi32(scr_x, coord_min), coord_max);
+
+        scr_y = _mm_sub_epi32(cntr_y,
+          _mm_srai_epi32(_mm_mullo_epi32(scale, fctr_c), 11));
+        below = _mm_cmplt_epi32(scr_y, zero);
+        above = _mm_andnot_si128(below, _mm_cmpgt_epi32(scr_y, win_h));
+        flg = _mm_or_si128(flg, _mm_and_si128(below, _mm_set1_epi32(0x04)));
+        flg = _mm_or_si128(flg, _mm_and_si128(above, _mm_set1_epi32(0x08)));
+        scr_y = _mm_min_epi32(_mm_max_epi32(scr_y, coord_min), coord_max);
+
+        transform_shpoints_store4_sse41(&p_sp[i], scr_x, scr_y, scr_d, flg);
+    }
+    transform_shpoints_scalar(p_dxc + i, p_dyc + i, p_dzc + i, p_sp + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void transform_shpoints_avx2(const s32 *p_dxc, const s32 *p_dyc,
+  const s32 *p_dzc, struct ShEnginePoint *p_sp, ulong count)
+{
+    __m256i rot_a, rot_b, rot_c, rot_d, scale;
+    __m256i cntr_x, cntr_y, win_w, win_h, coord_min, coord_max;
+    __m256i zero, flg_base;
+    ulong i;
+
+    rot_a = _mm256_set1_epi32(dword_176D10);
+    rot_b = _mm256_set1_epi32(dword_176D14);
+    rot_c = _mm256_set1_epi32(dword_176D18);
+    rot_d = _mm256_set1_epi32(dword_176D1C);
+    scale = _mm256_set1_epi32(overall_scale);
+    cntr_x = _mm256_set1_epi32(dword_176D3C);
+    cntr_y = _mm256_set1_epi32(dword_176D40);
+    // Compared with greater-than, so the window size is decreased by one
+    win_w = _mm256_set1_epi32(vec_window_width - 1);
+    win_h = _mm256_set1_epi32(vec_window_height - 1);
+    coord_min = _mm256_set1_epi32(SCREEN_POINT_COORD_MIN);
+    coord_max = _mm256_set1_epi32(SCREEN_POINT_COORD_MAX);
+    zero = _mm256_setzero_si256();
+    flg_base = _mm256_set1_epi32(0x40);
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        __m256i dxc, dyc, dzc;
+        __m256i fctr_a, fctr_b, fctr_c, scr_d;
+        __m256i scr_x, scr_y, flg, below, above;
+        s32 x[8], y[8], d[8], f[8];
+        int k;
+
+        dxc = _mm256_loadu_si256((const __m256i *)(p_dxc + i));
+        dyc = _mm256_loadu_si256((const __m256i *)(p_dyc + i));
+        dzc = _mm256_loadu_si256((const __m256i *)(p_dzc + i));
+
+        fctr_a = _mm256_srai_epi32(_mm256_sub_epi32(_mm256_mullo_epi32(rot_b, dxc),
+          _mm256_mullo_epi32(rot_a, dzc)), 16);
+        fctr_b = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(rot_a, dxc),
+          _mm256_mullo_epi32(rot_b, dzc)), 16);
+        fctr_c = _mm256_srai_epi32(_mm256_sub_epi32(_mm256_mullo_epi32(rot_d, dyc),
+          _mm256_mullo_epi32(rot_c, fctr_b)), 16);
+        scr_d = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(rot_c, dyc),
+          _mm256_mullo_epi32(rot_d, fctr_b)), 16);
+
+        scr_x = _mm256_add_epi32(cntr_x,
+          _mm256_srai_epi32(_mm256_mullo_epi32(scale, fctr_a), 11));
+        below = _mm256_cmpgt_epi32(zero, scr_x);
+        above = _mm256_andnot_si256(below, _mm256_cmpgt_epi32(scr_x, win_w));
+        flg = _mm256_or_si256(flg_base, _mm256_and_si256(below, _mm256_set1_epi32(0x01)));
+        flg = _mm256_or_si256(flg, _mm256_and_si256(above, _mm256_set1_epi32(0x02)));
+        scr_x = _mm256_min_epi32(_mm256_max_epi32(scr_x, coord_min), coord_max);
+
+        scr_y = _mm256_sub_epi32(cntr_y,
+          _mm256_srai_epi32(_mm256_mullo_epi32(scale, fctr_c), 11));
+        below = _mm256_cmpgt_epi32(zero, scr_y);
+        above = _mm256_andnot_si256(below, _mm256_cmpgt_epi32(scr_y, win_h));
+        flg = _mm256_or_si256(flg, _mm256_and_si256(below, _mm256_set1_epi32(0x04)));
+        flg = _mm256_or_si256(flg, _mm256_and_si256(above, _mm256_set1_epi32(0x08)));
+        scr_y = _mm256_min_epi32(_mm256_max_epi32(scr_y, coord_min), coord_max);
+
+        _mm256_storeu_si256((__m256i *)x, scr_x);
+        _mm256_storeu_si256((__m256i *)y, scr_y);
+        _mm256_storeu_si256((__m256i *)d, scr_d);
+        _mm256_storeu_si256((__m256i *)f, flg);
+        for (k = 0; k < 8; k++) {
+            p_sp[i + k].Flags = f[k];
+            p_sp[i + k].X = x[k];
+            p_sp[i + k].Y = y[k];
+            p_sp[i + k].Depth = d[k];
+        }
+    }
+    transform_shpoints_scalar(p_dxc + i, p_dyc + i, p_dzc + i, p_sp + i, count - i);
+}
+#endif
+
+static void transform_batch_kernel_select(void)
+{
+    transform_batch_kernel = TrBK_Scalar;
+#if defined(TRANSFORM_HAVE_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        transform_batch_kernel = TrBK_AVX2;
+    else if (__builtin_cpu_supports("sse4.1"))
+        transform_batch_kernel = TrBK_SSE41;
+#endif
+}
+
+void transform_shpoints(const s32 *p_dxc, const s32 *p_dyc, const s32 *p_dzc,
+  struct ShEnginePoint *p_sp, ulong count)
+{
+    if (transform_batch_kernel == TrBK_None)
+        transform_batch_kernel_select();
+
+    // Perspective 5 needs division per point; no gain from vectors there
+    if (game_perspective == 5) {
+        transform_shpoints_scalar(p_dxc, p_dyc, p_dzc, p_sp, count);
+        return;
+    }
+
+    switch (transform_batch_kernel)
+    {
+#if defined(TRANSFORM_HAVE_X86_SIMD)
+    case TrBK_AVX2:
+        transform_shpoints_avx2(p_dxc, p_dyc, p_dzc, p_sp, count);
+        break;
+    case TrBK_SSE41:
+        transform_shpoints_sse41(p_dxc, p_dyc, p_dzc, p_sp, count);
+        break;
+#endif
+    default:
+        transform_shpoints_scalar(p_dxc, p_dyc, p_dzc, p_sp, count);
+        break;
+    }
+}
+
+void engine_view_trig_update(void)
 {
     int angle;
 
     dword_176D4C = 0;
     dword_176D3C = vec_window_width / 2;
     dword_176D40 = vec_window_height / 2;
-    engn_anglexz += cam_rotation_velocity;
     dword_176D44 = 4 * (vec_window_width / 2) / 3;
     angle = (engn_anglexz >> 5) & LbFPMath_AngleMask;
     dword_176D0C = angle;
@@ -320,6 +542,12 @@ void process_engine_unk1(void)
     dword_176D1C = lbSinTable[angle + LbFPMath_PI/2];
 }
 
+void process_engine_unk1(void)
+{
+    engn_anglexz += cam_rotation_velocity;
+    engine_view_trig_update();
+}
+
 void transform_screen_to_map_isometric(int *dxc, int *dzc, int scr_x, int scr_y)
 {
     int fctr_a, fctr_b_part;